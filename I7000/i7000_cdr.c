@@ -39,6 +39,7 @@
 /* Flags for punch and reader. */
 #define ATTENA          (1 << (UNIT_V_UF+7))
 #define ATTENB          (1 << (UNIT_V_UF+14))
+#define UNIT_FAST       (1 << (UNIT_V_UF+8))    /* Whole card per event */
 
 
 /* std devices. data structures
@@ -73,6 +74,8 @@ UNIT                cdr_unit[] = {
 MTAB                cdr_mod[] = {
     {MTAB_XTD | MTAB_VUN, 0, "FORMAT", "FORMAT",
                &sim_card_set_fmt, &sim_card_show_fmt, NULL, "Set card format"},
+    {UNIT_FAST, 0, NULL, "NOFAST", NULL, NULL, NULL, "Read cards at device speed"},
+    {UNIT_FAST, UNIT_FAST, "FAST", "FAST", NULL, NULL, NULL, "Read whole card at once"},
 #ifdef I7070
     {ATTENA|ATTENB, 0, NULL, "NOATTEN", NULL, NULL, NULL, "No attention signal"},
     {ATTENA|ATTENB, ATTENA, "ATTENA", "ATTENA", NULL, NULL, NULL, "Signal Attention A"},
@@ -252,9 +255,11 @@ cdr_srv(UNIT *uptr) {
         return SCPE_OK;
     }
 
-    /* Copy next column over */
-    if (uptr->u5 & URCSTA_READ && uptr->u4 < 80) {
+    /* Copy next column over, in fast mode keep going while channel
+       is taking characters */
+    while (uptr->u5 & URCSTA_READ && uptr->u4 < 80) {
         uint8                ch = 0;
+        int                  r;
 
 #ifdef I7080
         /* Detect RSU */
@@ -294,7 +299,8 @@ cdr_srv(UNIT *uptr) {
             ch &= 0xf;
 #endif
 
-        switch(chan_write_char(chan, &ch, (uptr->u4 == 79)? DEV_REOR: 0)) {
+        r = chan_write_char(chan, &ch, (uptr->u4 == 79)? DEV_REOR: 0);
+        switch(r) {
         case TIME_ERROR:
         case END_RECORD:
             uptr->u5 |= URCSTA_WDISCO|URCSTA_BUSY;
@@ -305,7 +311,12 @@ cdr_srv(UNIT *uptr) {
             break;
         }
         sim_debug(DEBUG_DATA, &cdr_dev, "%d: Char > %04o %02o\n", u, image[uptr->u4-1], ch);
-        sim_activate(uptr, 10);
+        if ((uptr->flags & UNIT_FAST) == 0 || r != DATA_OK ||
+            (uptr->u5 & URCSTA_READ) == 0 || uptr->u4 >= 80 ||
+            chan_test(chan, DEV_FULL)) {
+            sim_activate(uptr, 10);
+            break;
+        }
     }
     return SCPE_OK;
 }
@@ -409,6 +420,12 @@ cdr_help(FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr)
    fprintf (st, "text only\n\n");
    fprintf (st, "   sim> SET %s LCOL=72    Sets column to select load mode\n\n", dptr->name);
 #endif
+   fprintf (st, "The reader sends one column to the channel each time it is\n");
+   fprintf (st, "serviced. With\n\n");
+   fprintf (st, "   sim> SET %s FAST\n\n", dptr->name);
+   fprintf (st, "it keeps sending columns until the card is done or the channel\n");
+   fprintf (st, "has a full word waiting to be stored. Programs that time the\n");
+   fprintf (st, "reader should be run with NOFAST.\n\n");
 #if NUM_DEVS_CDR > 1
 #ifdef I7010
    help_set_chan_type(st, dptr, "Card reader");
@@ -369,6 +369,9 @@ int chan_select(int chan);
 int chan_write_char(int chan, uint8 *data, int flags);
 int chan_read_char(int chan, uint8 *data, int flags);
 
+/* Channel data handling many words at a time (7090 only) */
+int chan_write_words(int chan, t_uint64 *data, int len, int *used, int flags);
+
 /* Flag end of file on channel */
 void chan_set_eof(int chan);
 
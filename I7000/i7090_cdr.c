@@ -29,6 +29,7 @@
 #ifdef NUM_DEVS_CDR
 
 #define UNIT_CDR        UNIT_ATTABLE | UNIT_RO | UNIT_DISABLE | MODE_026
+#define UNIT_FAST       (1 << (UNIT_V_UF + 8))   /* Whole card per event */
 
 
 /* std devices. data structures
@@ -70,6 +71,10 @@ UNIT                cdr_unit[] = {
 MTAB                cdr_mod[] = {
     {MTAB_XTD | MTAB_VUN, 0, "FORMAT", "FORMAT",
                &sim_card_set_fmt, &sim_card_show_fmt, NULL},
+    {UNIT_FAST, 0, NULL, "NOFAST", NULL, NULL, NULL,
+               "Read cards at device speed"},
+    {UNIT_FAST, UNIT_FAST, "FAST", "FAST", NULL, NULL, NULL,
+               "Read whole card at once"},
 #if NUM_CHAN != 1
     {MTAB_XTD | MTAB_VUN | MTAB_VALR, 0, "CHAN", "CHAN", &set_chan,
         &get_chan, NULL},
@@ -125,6 +130,8 @@ t_stat cdr_srv(UNIT * uptr)
     uint16              *image = (uint16 *)(uptr->up7);
     uint16              bit;
     t_uint64            mask, wd;
+    t_uint64            rows[24];
+    int                 n;
 
     /* Channel has disconnected, abort current read. */
     if (uptr->u5 & URCSTA_CMD && chan_stat(chan, DEV_DISCO)) {
@@ -136,6 +143,9 @@ t_stat cdr_srv(UNIT * uptr)
 
     /* Check to see if we have timed out */
     if (uptr->wait != 0) {
+        /* In fast mode only stop at restart point and end of wait */
+        if (uptr->flags & UNIT_FAST)
+            uptr->wait = (uptr->wait > 30) ? 30 : 1;
         /* If at end of record and channel is still active, do another read */
         if (uptr->wait == 30
             && ((uptr->u5 & (URCSTA_CMD|URCSTA_IDLE|URCSTA_READ|URCSTA_ON))
@@ -200,26 +210,37 @@ t_stat cdr_srv(UNIT * uptr)
         return SCPE_OK;
     }
 
-    /* Bit flip into read buffer */
-    bit = 1 << (pos / 2);
-    mask = 1;
-    wd = 0;
-    b = (pos & 1)?36:0;
+    /* Bit flip into read buffer, in fast mode do rest of card */
+    for (n = 0; pos + n < 24; n++) {
+        bit = 1 << ((pos + n) / 2);
+        mask = 1;
+        wd = 0;
+        b = ((pos + n) & 1)?36:0;
 
-    for (col = 35; col >= 0; mask <<= 1) {
-        if (image[col-- + b] & bit)
-             wd |= mask;
+        for (col = 35; col >= 0; mask <<= 1) {
+            if (image[col-- + b] & bit)
+                 wd |= mask;
+        }
+        rows[n] = wd;
+        if ((uptr->flags & UNIT_FAST) == 0) {
+            n++;
+            break;
+        }
     }
 
-    switch (chan_write (chan, &wd,/* (pos == 23) ? DEV_REOR :*/ 0)) {
+    switch (chan_write_words(chan, rows, n, &n, 0)) {
     case DATA_OK:
-        sim_debug(DEBUG_DATA, &cdr_dev, "unit=%d read row %d %012llo\n", u,
-                  pos, wd);
-        pos++;
+        for (b = 0; b < n; b++)
+            sim_debug(DEBUG_DATA, &cdr_dev, "unit=%d read row %d %012llo\n",
+                      u, pos + b, rows[b]);
+        pos += n;
         uptr->u5 &= ~CDRPOSMASK;
         uptr->u5 |= pos << CDRPOSSHIFT;
         uptr->wait = 0;
-        sim_activate(uptr, (pos & 1) ? us_to_ticks(300) : us_to_ticks(8000));
+        if (uptr->flags & UNIT_FAST)
+            sim_activate(uptr, us_to_ticks(300));
+        else
+            sim_activate(uptr, (pos & 1) ? us_to_ticks(300) : us_to_ticks(8000));
         return SCPE_OK;
 
     case END_RECORD:
@@ -330,6 +351,13 @@ cdr_help(FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr)
    fprintf (st, "The %s supports one card reader\n\n", cpu);
 #endif
    help_set_chan_type(st, dptr, "Card readers");
+   fprintf (st, "Each card is read as 24 words, the left and right halves of\n");
+   fprintf (st, "the 12 rows, at the speed of the real reader. With\n\n");
+   fprintf (st, "   sim> SET %s FAST\n\n", dptr->name);
+   fprintf (st, "a 7607 channel takes the rows up to the last word of the current\n");
+   fprintf (st, "channel command in one go, and the wait between cards is cut\n");
+   fprintf (st, "short at the restart point. Stored words run ahead of the clock,\n");
+   fprintf (st, "so diagnostics should be run with NOFAST.\n\n");
    fprint_set_help(st, dptr);
    fprint_show_help(st, dptr);
    fprintf (st, "\n");
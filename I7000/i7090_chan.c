@@ -278,50 +278,44 @@ chan_boot(int32 unit_num, DEVICE * dptr)
     return SCPE_OK;
 }
 
+/* BCD translation tables for 7909 channel, indexed by direction */
+static const uint8  bcd_xlat_tab[2][64] = {
+    {   /* M->D Write */
+    012, 001, 002, 003, 004, 005, 006, 007,
+    010, 011, 020, 013, 014, 015, 016, 017,
+    060, 061, 062, 063, 064, 065, 066, 067,
+    070, 071, 072, 073, 074, 075, 076, 077,
+    040, 041, 042, 043, 044, 045, 046, 047,
+    050, 051, 052, 053, 054, 055, 056, 057,
+    020, 021, 022, 023, 024, 025, 026, 027,
+    030, 031, 032, 033, 034, 035, 036, 037,
+    },
+    {   /* D->M Read */
+    060, 001, 002, 003, 004, 005, 006, 007,
+    010, 011, 000, 013, 014, 015, 016, 017,
+    060, 061, 062, 063, 064, 065, 066, 067,
+    070, 071, 072, 073, 074, 075, 076, 077,
+    040, 041, 042, 043, 044, 045, 046, 047,
+    050, 051, 052, 053, 054, 055, 056, 057,
+    020, 021, 022, 023, 024, 025, 026, 027,
+    030, 031, 032, 033, 034, 035, 036, 037,
+    }
+};
+
 /* Preform BCD to binary translation for 7909 channel */
 void
 bcd_xlat(int chan, int direction)
 {
-    int                 i;
-    t_uint64            na = 0;
-
-    for (i = 30; i >= 0; i -= 6) {
-        uint8               ch = (uint8)(assembly[chan] >> i) & 077;
-
-        if (direction) {        /* D->M Read */
-            switch (ch & 060) {
-            case 000:
-                if (ch == 0)
-                    ch = 060;
-                else if (ch == 012)
-                    ch = 0;
-                break;
-            case 020:
-            case 060:
-                ch ^= 040;
-            case 040:
-                break;
-            }
-        } else {                /* M->D Write */
-            switch (ch & 060) {
-            case 000:
-                if (ch == 0)
-                    ch = 012;
-                else if (ch == 012)
-                    ch = 020;
-                break;
-            case 060:
-                if (ch == 060)
-                    ch = 060;   /* => 000 */
-            case 020:
-                ch ^= 040;
-            case 040:
-                break;
-            }
-        }
-        na |= ((t_uint64) ch) << i;
-    }
-    assembly[chan] = na;
+    const uint8        *tab = bcd_xlat_tab[direction != 0];
+    t_uint64            wd = assembly[chan];
+
+    assembly[chan] =
+        ((t_uint64) tab[(wd >> 30) & 077] << 30) |
+        ((t_uint64) tab[(wd >> 24) & 077] << 24) |
+        ((t_uint64) tab[(wd >> 18) & 077] << 18) |
+        ((t_uint64) tab[(wd >> 12) & 077] << 12) |
+        ((t_uint64) tab[(wd >> 6) & 077] << 6) |
+         (t_uint64) tab[wd & 077];
 }
 
 /* Execute the next channel instruction. */
@@ -1654,6 +1648,80 @@ chan_read_char(int chan, uint8 * data, int flags)
     return DATA_OK;
 }
 
+/*
+ * Word block transfers.
+ *
+ * The first word is handled exactly like chan_write and its status
+ * returned.  After that the channel keeps taking words as long as a 7607
+ * channel is in the middle of a data command: each word is stored to
+ * memory here, the way chan_proc would do it, instead of waiting for the
+ * next chan_proc pass.  The transfer stops short of the last word of the
+ * command, of an EOR or disconnect, and of anything else chan_proc must
+ * see, so IOCD/IOCT/TCH sequencing is still done there.  *used is set to
+ * the number of words transferred.  This runs the channel ahead of
+ * simulated time, so devices only use it when asked to (SET CDR FAST).
+ * There is no character or whole record block interface: tape, disk and
+ * card devices otherwise move one character per chan_proc pass through
+ * chan_write_char/chan_read_char.
+ */
+static int
+chan_block_ok(int chan)
+{
+    if (CHAN_G_TYPE(chan_unit[chan].flags) != CHAN_7607)
+        return 0;
+    if ((chan_flags[chan] & (STA_ACTIVE|DEV_SEL)) != (STA_ACTIVE|DEV_SEL))
+        return 0;
+    if (chan_flags[chan] & (DEV_DISCO|DEV_REOR|DEV_WEOR|CHS_ATTN|STA_WAIT))
+        return 0;
+    return (cmd[chan] & 070) != TCH;
+}
+
+/* Store a full assembly register if not at end of command */
+static int
+chan_store_word(int chan)
+{
+    if (!chan_block_ok(chan) || (chan_flags[chan] & DEV_WRITE) ||
+        wcount[chan] <= 1)
+        return 0;
+    if ((cmd[chan] & 1) == 0) {
+        if (chan_dev.dctrl & (0x0100 << chan))
+            sim_debug(DEBUG_DATA, &chan_dev, "chan %d data < %012llo\n",
+                      chan, assembly[chan]);
+        M[caddr[chan]] = assembly[chan];
+    } else {
+        if (chan_dev.dctrl & (0x0100 << chan))
+            sim_debug(DEBUG_DATA, &chan_dev, "chan %d data * %012llo\n",
+                      chan, assembly[chan]);
+    }
+    nxt_chan_addr(chan);
+    assembly[chan] = 0;
+    bcnt[chan] = 6;
+    wcount[chan]--;
+    chan_flags[chan] &= ~DEV_FULL;
+    return 1;
+}
+
+int
+chan_write_words(int chan, t_uint64 * data, int len, int *used, int flags)
+{
+    int     r;
+    int     i;
+
+    *used = 0;
+    if (len <= 0)
+        return DATA_OK;
+    r = chan_write(chan, &data[0], (len == 1) ? flags : 0);
+    if (r != DATA_OK)
+        return r;
+    for (i = 1; i < len; i++) {
+        if (!chan_store_word(chan))
+            break;
+        chan_write(chan, &data[i], (i == len - 1) ? flags : 0);
+    }
+    *used = i;
+    return DATA_OK;
+}
+
 void
 chan9_seqcheck(int chan)
 {
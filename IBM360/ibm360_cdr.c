@@ -35,6 +35,7 @@
 
 #ifdef NUM_DEVS_CDR
 #define UNIT_CDR       UNIT_ATTABLE | UNIT_RO | UNIT_DISABLE | MODE_029
+#define UNIT_FAST      (1 << (UNIT_V_UF + 7))   /* Whole card per event */
 
 /* Device status information stored in u3 */
 #define CMD            u3
@@ -94,6 +95,10 @@ MTAB                cdr_mod[] = {
     {MTAB_XTD | MTAB_VUN, 0, "FORMAT", "FORMAT",
                &sim_card_set_fmt, &sim_card_show_fmt, NULL,
                "Set defualt format for reading cards in"},
+    {UNIT_FAST, 0, NULL, "NOFAST", NULL, NULL, NULL,
+               "Read cards at device speed"},
+    {UNIT_FAST, UNIT_FAST, "FAST", "FAST", NULL, NULL, NULL,
+               "Read whole card at once"},
     {MTAB_XTD | MTAB_VUN | MTAB_VALR, 0, "DEV", "DEV", &set_dev_addr,
         &show_dev_addr, NULL, "Set device address"},
     {0}
@@ -255,19 +260,22 @@ cdr_srv(UNIT *uptr) {
             uptr->SNS = SNS_DATCHK;
             goto feed;
         }
-        xlat = sim_hol_to_ebcdic(image[uptr->COL]);
-
-        if (xlat == 0x100) {
-            uptr->SNS |= SNS_DATCHK;
-            ch = 0x00;
-        } else
-            ch = (uint8)(xlat&0xff);
-        if (chan_write_byte(addr, &ch)) {
-            goto feed;
-        } else {
-            uptr->COL++;
-            sim_debug(DEBUG_DATA, &cdr_dev, "%d: Char > %02o\n", u, ch);
-        }
+        /* In fast mode send rest of card, else just next column */
+        do {
+            xlat = sim_hol_to_ebcdic(image[uptr->COL]);
+
+            if (xlat == 0x100) {
+                uptr->SNS |= SNS_DATCHK;
+                ch = 0x00;
+            } else
+                ch = (uint8)(xlat&0xff);
+            if (chan_write_byte(addr, &ch)) {
+                goto feed;
+            } else {
+                uptr->COL++;
+                sim_debug(DEBUG_DATA, &cdr_dev, "%d: Char > %02o\n", u, ch);
+            }
+        } while ((uptr->flags & UNIT_FAST) != 0 && uptr->COL < 80);
         if (uptr->COL == 80) {
             goto feed;
         }
@@ -355,6 +363,11 @@ t_stat
 cdr_help(FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr)
 {
    fprintf (st, "2540R Card Reader\n\n");
+   fprintf (st, "Columns are translated to EBCDIC and sent to the channel one\n");
+   fprintf (st, "at a time. With\n\n");
+   fprintf (st, "   sim> SET %s FAST\n\n", dptr->name);
+   fprintf (st, "the rest of the card is sent in one service call, stopping early\n");
+   fprintf (st, "when the CCW count runs out.\n\n");
    sim_card_attach_help(st, dptr, uptr, flag, cptr);
    fprint_set_help(st, dptr);
    fprint_show_help(st, dptr);
@@ -135,6 +135,17 @@ uint32              adrmask;                    /* Mask for addressing memory */
 uint32              memmask;                    /* Memory address range mask */
 uint8               loading;                    /* Loading bootstrap */
 
+/* Memory window for Mem_read/Mem_write, indexed by the flag argument.
+   Rebuilt by mem_window() whenever exe_mode, Mode, RD, RL or memmask change.
+   Addresses below limit (and not aliased to XR) are at M[base + addr],
+   everything else goes through the full datum/limit checks. */
+struct mem_win
+{
+    uint32    base;                             /* Datum added to address */
+    uint32    limit;                            /* First address not in window */
+    uint8     xr;                               /* Addresses < 8 are registers */
+} mwin[2];
+
 
 struct InstHistory
 {
@@ -320,10 +331,39 @@ DEVICE              cpu_dev = {
 
 
 
+/* Compute memory windows for current mode, datum and limit */
+void mem_window(void) {
+    struct mem_win *w;
+    uint32  top;
+    int     f;
+
+    for (f = 0; f < 2; f++) {
+        w = &mwin[f];
+        top = memmask + 1;
+        if (top > MEMSIZE + 1)
+            top = MEMSIZE + 1;
+        if (!exe_mode) {
+            w->base = RD;
+            w->xr = 1;
+            if (RL && top > RL)
+                top = RL;
+        } else if (f && (Mode & DATUM) != 0) {
+            w->base = RD;
+            w->xr = 0;
+        } else {
+            w->base = 0;
+            w->xr = 1;
+        }
+        w->limit = (top > w->base) ? top - w->base : 0;
+    }
+}
+
 /* Test if we can access a word */
 uint8 Mem_test(uint32 addr) {
     addr &= M22;
 
+    if (addr < mwin[0].limit)
+        return 0;
     if (!exe_mode) {
         if (addr < 8)
             return 0;
@@ -344,9 +384,15 @@ uint8 Mem_test(uint32 addr) {
 }
 
 uint8 Mem_read(uint32 addr, uint32 *data, uint8 flag) {
+    struct mem_win *w = &mwin[flag != 0];
+
     addr &= M22;
 
     SR1++;
+    if (addr < w->limit && (addr >= 8 || !w->xr)) {
+        *data = M[w->base + addr];
+        return 0;
+    }
     if (!exe_mode) {
         if (addr < 8) {
             *data = XR[addr];
@@ -374,8 +420,14 @@ uint8 Mem_read(uint32 addr, uint32 *data, uint8 flag) {
 }
 
 uint8 Mem_write(uint32 addr, uint32 *data, uint8 flag) {
+    struct mem_win *w = &mwin[flag != 0];
+
     addr &= M22;
 
+    if (addr < w->limit && (addr >= 8 || !w->xr)) {
+        M[w->base + addr] = *data;
+        return 0;
+    }
     if (!exe_mode) {
         if (addr < 8) {
             XR[addr] = *data;
@@ -401,6 +453,16 @@ uint8 Mem_write(uint32 addr, uint32 *data, uint8 flag) {
     return 0;
 }
 
+/* Return pointer to n words at addr if they are all inside the memory window */
+uint32 *Mem_block(uint32 addr, uint32 n, uint8 flag) {
+    struct mem_win *w = &mwin[flag != 0];
+
+    addr &= M22;
+    if ((w->xr && addr < 8) || addr + n > w->limit)
+        return NULL;
+    return &M[w->base + addr];
+}
+
 t_stat
 sim_instr(void)
 {
@@ -410,9 +472,11 @@ sim_instr(void)
     int                 n;              /* Generic short term temp register */
     int                 e1,e2;          /* Temp for exponents */
     int                 f;              /* Used to hold flags */
+    uint32             *src, *dst;      /* Block move pointers */
 
     memmask = (CPU_TYPE < TYPE_C1) ? M15: M22;
     adrmask = (Mode & AM22) ? M22 : M15;
+    mem_window();
     reason = chan_set_devs();
 
     while (reason == SCPE_OK) {        /* loop until halted */
@@ -438,6 +502,7 @@ sim_instr(void)
            if ((SR64 | SR65) != 0) {
               loading = 0;
               exe_mode = 1;
+              mem_window();
               RC = 020;
            }
            sim_interval--;
@@ -448,6 +513,7 @@ intr:
             if (CPU_TYPE < TYPE_C1 && !exe_mode)
                 RC += RD;
             exe_mode = 1;
+            mem_window();
             loading = 0;
             /* Store registers */
             if (cpu_flags & FLOAT && cpu_flags & SL_FLOAT) {
@@ -493,6 +559,7 @@ intr:
                Mem_write(RD+n, &XR[n], 0);
             BV = BCarry = Mode = Zero = 0;
             adrmask = M15;
+            mem_window();
             RC = 020;
             PIP = 0;
        }
@@ -1598,6 +1665,7 @@ norm1:
                        Mode = RB & 076;
                     Zero = RB & 1;
                     adrmask = (Mode & AM22) ? M22 : M15;
+                    mem_window();
                     break;
 
        case OP_MOVE:        /* Copy N words */
@@ -1606,6 +1674,19 @@ norm1:
                     RK = RB;
                     RA &= adrmask;
                     RB = XR[(RX+1) & 07] & adrmask;
+                    /* Copy directly if both blocks are inside memory window */
+                    n = ((RK - 1) & 0777) + 1;
+                    src = Mem_block(RA, n, 1);
+                    dst = Mem_block(RB, n, 1);
+                    if (src != NULL && dst != NULL) {
+                        for (m = 0; m < n; m++)   /* Forward for overlaps */
+                            dst[m] = src[m];
+                        SR1 += n;
+                        RA += n;
+                        RB += n;
+                        RK = 0;
+                        break;
+                    }
                     do {
                         if (Mem_read(RA, &RT, 1)) {
                             goto intr;
@@ -2286,6 +2367,7 @@ fn:
                              Mode = RA & 077;
                          }
                          adrmask = (Mode & (AM22)) ? M22 : M15;
+                         mem_window();
 //fprintf(stderr, "Load C=%08o limit: %08o D:=%08o %02o\n\r", RC, RL, RD, Mode);
                          if (RF & 1)                 /* Check if 172 or 173 order code */
                              break;
@@ -2317,6 +2399,7 @@ fn:
                              facch &= M23;
                          }
                          exe_mode = 0;
+                         mem_window();
                          break;
                     }
                     /* Fall through */
@@ -2376,6 +2459,7 @@ voluntary:
                     if ((CPU_TYPE < TYPE_C1) && !exe_mode)
                         RC += RD;
                     exe_mode = 1;
+                    mem_window();
                     if (cpu_flags & FLOAT && cpu_flags & SL_FLOAT) {
                        /* Store registers */
                        Mem_write(RD+12, &faccl, 0);
@@ -2408,6 +2492,7 @@ voluntary:
                     Zero = Mode = 0;
                     BCarry = BV = 0;
                     adrmask = M15;
+                    mem_window();
                     if ((cpu_flags & SV) != 0) {
                         if ((RF & 0170) == 0140 || (RF & 0170) == 0110)
                            XR[1] = RD+RX;
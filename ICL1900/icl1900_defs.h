@@ -290,6 +290,8 @@ extern int chan_input_char(int dev, uint8 *data, int eor);
 extern int chan_output_char(int dev, uint8 *data, int eor);
 extern int chan_input_word(int dev, uint32 *data, int eor);
 extern int chan_output_word(int dev, uint32 *data, int eor);
+extern int chan_input_block(int dev, uint32 *data, int n, int *cnt);
+extern int chan_output_block(int dev, uint32 *data, int n, int *cnt);
 extern void chan_set_done(int dev);
 extern void chan_clr_done(int dev);
 
@@ -80,6 +80,12 @@
 
 #define MT_QUAL      0100             /* Qualifier expected */
 #define MT_BUSY      0200             /* Device running command */
+#define MT_TERM      0400             /* Record moved, waiting for end */
+
+/* Timing, a record takes the start/stop time plus the time for each
+   character to pass the heads. */
+#define MT_GAP       10               /* Start/stop time */
+#define MT_CHAR      20               /* Time for one character */
 
 #define ST1_OK       001              /* Unit available */
 #define ST1_WARN     002              /* Warning, EOT, BOT, TM */
@@ -102,6 +108,7 @@
 int  mt_busy;    /* Indicates that controller is talking to a drive */
 int  mt_drive;   /* Indicates last selected drive */
 uint8 mt_buffer[BUFFSIZE];
+uint32 mt_words[(BUFFSIZE + 2) / 3];  /* Record packed into words */
 void mt_cmd (uint32 dev, uint32 cmd, uint32 *resp);
 t_stat mt_svc (UNIT *uptr);
 t_stat mt_reset (DEVICE *dptr);
@@ -241,66 +248,73 @@ t_stat mt_svc (UNIT *uptr)
     uint32       word;
     int          i;
     int          stop;
-    int          eor;
+    int          n;
+    t_mtrlnt     pos;
 
     /* If not busy, false schedule, just exit */
     if ((uptr->CMD & MT_BUSY) == 0)
         return SCPE_OK;
+
+    /* Record has been moved, signal end of transfer */
+    if (uptr->CMD & MT_TERM) {
+        uptr->CMD = 0;
+        mt_busy = 0;
+        chan_set_done(dev);
+        return SCPE_OK;
+    }
     switch (uptr->CMD & MT_CMD) {
     case MT_BOOT:
     case MT_READ:
-         /* If empty buffer, fill */
-         if (BUF_EMPTY(uptr)) {
-             sim_debug(DEBUG_DETAIL, dptr, "Read unit=%d ", unit);
-             if ((r = sim_tape_rdrecf(uptr, &mt_buffer[0], &reclen,
-                              BUFFSIZE)) != MTSE_OK) {
-                 sim_debug(DEBUG_DETAIL, dptr, " error %d\n", r);
-                 uptr->STATUS = STQ_TERM;
-                 if (r == MTSE_TMK)
-                     uptr->STATUS |= ST1_WARN;
-                 else if (r == MTSE_WRP)
-                     uptr->STATUS |= ST1_ERR;
-                 else if (r == MTSE_EOM)
-                     uptr->STATUS |= ST1_ERR|ST2_BLNK;
-                 else
-                     uptr->STATUS |= ST1_ERR;
-                 uptr->CMD = 0;
-                 mt_busy = 0;
-                 chan_set_done(dev);
-                 return SCPE_OK;
-             }
-             uptr->hwmark = reclen;
-             sim_debug(DEBUG_DETAIL, dptr, "Block %d chars\n", reclen);
-         }
-         stop = 0;
-
-         /* Grab three chars off buffer */
-         word = 0;
-         for(i = 16; i >= 0; i-=8) {
-             if ((uint32)uptr->POS >= uptr->hwmark) {
-                /* Add in fill characters */
-                if (i == 8) {
-                   stop = 2;
-                } else if (i == 16) {
-                   stop = 1;
-                }
-                break;
-             }
-             word |= (uint32)mt_buffer[uptr->POS++] << i;
-         }
-         sim_debug(DEBUG_DATA, dptr, "unit=%d read %08o\n", unit, word);
-         eor = chan_input_word(dev, &word, 0);
-         if (eor || (uint32)uptr->POS >= uptr->hwmark) {
-             uptr->STATUS = (stop << 12) | STQ_TERM;
-             if ((uint32)uptr->POS < uptr->hwmark)
-                  uptr->STATUS |= ST1_LONG;
-             sim_debug(DEBUG_DATA, dptr, "unit=%d read done %08o %d\n", unit, uptr->STATUS, uptr->POS);
+         sim_debug(DEBUG_DETAIL, dptr, "Read unit=%d ", unit);
+         if ((r = sim_tape_rdrecf(uptr, &mt_buffer[0], &reclen,
+                          BUFFSIZE)) != MTSE_OK) {
+             sim_debug(DEBUG_DETAIL, dptr, " error %d\n", r);
+             uptr->STATUS = STQ_TERM;
+             if (r == MTSE_TMK)
+                 uptr->STATUS |= ST1_WARN;
+             else if (r == MTSE_WRP)
+                 uptr->STATUS |= ST1_ERR;
+             else if (r == MTSE_EOM)
+                 uptr->STATUS |= ST1_ERR|ST2_BLNK;
+             else
+                 uptr->STATUS |= ST1_ERR;
              uptr->CMD = 0;
              mt_busy = 0;
              chan_set_done(dev);
              return SCPE_OK;
          }
-         sim_activate(uptr, 100);
+         sim_debug(DEBUG_DETAIL, dptr, "Block %d chars\n", reclen);
+
+         /* Pack the whole record, three chars to a word */
+         stop = 0;
+         pos = 0;
+         for (n = 0; pos < reclen; n++) {
+             word = 0;
+             for(i = 16; i >= 0; i-=8) {
+                 if (pos >= reclen) {
+                    /* Add in fill characters */
+                    if (i == 8) {
+                       stop = 2;
+                    } else if (i == 16) {
+                       stop = 1;
+                    }
+                    break;
+                 }
+                 word |= (uint32)mt_buffer[pos++] << i;
+             }
+             sim_debug(DEBUG_DATA, dptr, "unit=%d read %08o\n", unit, word);
+             mt_words[n] = word;
+         }
+         chan_input_block(dev, &mt_words[0], n, &i);
+         uptr->STATUS = STQ_TERM;
+         if (i < n)
+              uptr->STATUS |= ST1_LONG;
+         else
+              uptr->STATUS |= stop << 12;
+         uptr->POS = (i < n) ? 3 * (i + 1) : reclen;
+         sim_debug(DEBUG_DATA, dptr, "unit=%d read done %08o %d\n", unit, uptr->STATUS, uptr->POS);
+         uptr->CMD |= MT_TERM;
+         sim_activate(uptr, MT_GAP + (MT_CHAR * reclen));
          break;
 
     case MT_WRITEERG: /* Write and Erase */
@@ -314,85 +328,79 @@ t_stat mt_svc (UNIT *uptr)
              return SCPE_OK;
          }
 
-         eor = chan_output_word(dev, &word, 0);
-         sim_debug(DEBUG_DATA, dptr, "unit=%d write %08o\n", unit, word);
+         /* Gather the whole record from the channel, no more words
+            than fit in the buffer at three chars each */
+         chan_output_block(dev, &mt_words[0], BUFFSIZE / 3, &n);
+
+         /* Put three chars in buffer for each word */
+         reclen = 0;
+         for (i = 0; i < n; i++) {
+             word = mt_words[i];
+             sim_debug(DEBUG_DATA, dptr, "unit=%d write %08o\n", unit, word);
+             mt_buffer[reclen++] = (uint8)((word >> 16) & 0xff);
+             mt_buffer[reclen++] = (uint8)((word >> 8) & 0xff);
+             mt_buffer[reclen++] = (uint8)(word & 0xff);
+         }
+         sim_debug(DEBUG_DETAIL, dptr, "Write unit=%d Block %d chars\n",
+                  unit, reclen);
+         uptr->STATUS = STQ_TERM;
+         if (reclen == 0 || sim_tape_wrrecf(uptr, &mt_buffer[0], reclen) != MTSE_OK)
+            uptr->STATUS |= ST1_ERR;
+         uptr->CMD |= MT_TERM;
+         sim_activate(uptr, MT_GAP + (MT_CHAR * reclen));
+         break;
 
-         /* Put three chars in buffer */
-         for(i = 16; i >= 0; i-=8) {
-             mt_buffer[uptr->POS++] = (uint8)((word >> i) & 0xff);
+    case MT_REV_READ:
+         if (sim_tape_bot(uptr)) {
+             uptr->STATUS = ST1_WARN|ST1_ERR;
+             uptr->CMD = 0;
+             mt_busy = 0;
+             chan_set_done(dev);
+             return SCPE_OK;
          }
-         uptr->hwmark = uptr->POS;
-         if (eor) {
-             /* Done with transfer */
-             reclen = uptr->hwmark;
-             sim_debug(DEBUG_DETAIL, dptr, "Write unit=%d Block %d chars\n",
-                      unit, reclen);
-             r = sim_tape_wrrecf(uptr, &mt_buffer[0], reclen);
+         sim_debug(DEBUG_DETAIL, dptr, "Read rev unit=%d ", unit);
+         if ((r = sim_tape_rdrecr(uptr, &mt_buffer[0], &reclen,
+                          BUFFSIZE)) != MTSE_OK) {
+             sim_debug(DEBUG_DETAIL, dptr, " error %d\n", r);
              uptr->STATUS = STQ_TERM;
-             if (r != MTSE_OK)
-                uptr->STATUS |= ST1_ERR;
+             if (r == MTSE_TMK)
+                 uptr->STATUS |= ST1_WARN;
+             else if (r == MTSE_EOM)
+                 uptr->STATUS |= ST1_WARN;
+             else
+                 uptr->STATUS |= ST1_ERR;
              uptr->CMD = 0;
              mt_busy = 0;
              chan_set_done(dev);
              return SCPE_OK;
          }
-         sim_activate(uptr, 100);
-         break;
+         sim_debug(DEBUG_DETAIL, dptr, "Block %d chars\n", reclen);
 
-    case MT_REV_READ:
-         /* If empty buffer, fill */
-         if (BUF_EMPTY(uptr)) {
-             if (sim_tape_bot(uptr)) {
-                 uptr->STATUS = ST1_WARN|ST1_ERR;
-                 uptr->CMD = 0;
-                 mt_busy = 0;
-                 chan_set_done(dev);
-                 return SCPE_OK;
-             }
-             sim_debug(DEBUG_DETAIL, dptr, "Read rev unit=%d ", unit);
-             if ((r = sim_tape_rdrecr(uptr, &mt_buffer[0], &reclen,
-                              BUFFSIZE)) != MTSE_OK) {
-                 sim_debug(DEBUG_DETAIL, dptr, " error %d\n", r);
-                 uptr->STATUS = STQ_TERM;
-                 if (r == MTSE_TMK)
-                     uptr->STATUS |= ST1_WARN;
-                 else if (r == MTSE_EOM)
-                     uptr->STATUS |= ST1_WARN;
-                 else
-                     uptr->STATUS |= ST1_ERR;
-                 uptr->CMD = 0;
-                 mt_busy = 0;
-                 chan_set_done(dev);
-                 return SCPE_OK;
-             }
-             uptr->POS = reclen;
-             uptr->hwmark = reclen;
-             sim_debug(DEBUG_DETAIL, dptr, "Block %d chars\n", reclen);
-         }
-
-         /* Grab three chars off buffer */
-         word = 0;
+         /* Pack the whole record from the end, three chars to a word */
          stop = 0;
-         for(i = 0; i <= 16; i+=8) {
-             word |= (uint32)mt_buffer[--uptr->POS] << i;
-             if (uptr->POS == 0) {
-                stop = 1;
-                break;
+         pos = reclen;
+         for (n = 0; pos > 0; n++) {
+             word = 0;
+             for(i = 0; i <= 16; i+=8) {
+                 word |= (uint32)mt_buffer[--pos] << i;
+                 if (pos == 0) {
+                    stop = 1;
+                    break;
+                 }
              }
+             sim_debug(DEBUG_DATA, dptr, "unit=%d read %08o\n", unit, word);
+             mt_words[n] = word;
          }
-         sim_debug(DEBUG_DATA, dptr, "unit=%d read %08o\n", unit, word);
-         eor = chan_input_word(dev, &word, 0);
-         if (eor || uptr->POS == 0) {
-             uptr->STATUS = (stop << 12) |STQ_TERM;
-             if (uptr->POS != 0)
-                  uptr->STATUS |= ST1_LONG;
-             sim_debug(DEBUG_DATA, dptr, "unit=%d read done %08o %d\n", unit, uptr->STATUS, uptr->POS);
-             uptr->CMD = 0;
-             mt_busy = 0;
-             chan_set_done(dev);
-             return SCPE_OK;
-         }
-         sim_activate(uptr, 100);
+         chan_input_block(dev, &mt_words[0], n, &i);
+         uptr->STATUS = STQ_TERM;
+         if (i < n)
+              uptr->STATUS |= ST1_LONG;
+         else
+              uptr->STATUS |= stop << 12;
+         uptr->POS = (i < n) ? reclen - 3 * (i + 1) : 0;
+         sim_debug(DEBUG_DATA, dptr, "unit=%d read done %08o %d\n", unit, uptr->STATUS, uptr->POS);
+         uptr->CMD |= MT_TERM;
+         sim_activate(uptr, MT_GAP + (MT_CHAR * reclen));
          break;
 
     case MT_FSF:
@@ -416,7 +424,7 @@ t_stat mt_svc (UNIT *uptr)
                   sim_activate(uptr, 50);
               } else {
                   sim_debug(DEBUG_DETAIL, dptr, "%d\n", reclen);
-                  sim_activate(uptr, 10 + (20 * reclen));
+                  sim_activate(uptr, MT_GAP + (MT_CHAR * reclen));
               }
               break;
          case 2:
@@ -60,12 +60,19 @@
  *   Lower 3 bits is command.
  *   Next bit is binary/BCD.
  *   Next bit is disconnect flag.
+ *   Next bit is record moved, waiting for end.
  *   Top 16 bits are count.
  */
 
 #define MT_CMD      007
 #define BCD         010
 #define DISC        020
+#define DONE        040
+
+/* Timing, a record takes the start/stop time plus the time for each
+   character to pass the heads. */
+#define MT_GAP      10
+#define MT_CHAR     10
 
 #define BUF_EMPTY(u)  (u->hwmark == 0xFFFFFFFF)
 #define CLR_BUF(u)     u->hwmark =  0xFFFFFFFF
@@ -235,106 +242,114 @@ t_stat mta_svc (UNIT *uptr)
     if ((uptr->STATUS & BUSY) == 0)
         return SCPE_OK;
 
+    /* Record has been moved, signal end of transfer */
+    if (uptr->CMD & DONE) {
+       uptr->CMD &= ~DONE;
+       uptr->STATUS |= TERMINATE;
+       uptr->STATUS &= ~BUSY;
+       mta_busy = 0;
+       chan_set_done(dev);
+       return SCPE_OK;
+    }
+
     switch (uptr->CMD & MT_CMD) {
     case MT_READ:
-         /* If empty buffer, fill */
-         if (BUF_EMPTY(uptr)) {
-             sim_debug(DEBUG_DETAIL, dptr, "Read unit=%d ", unit);
-             if ((r = sim_tape_rdrecf(uptr, &mta_buffer[0], &reclen,
-                              BUFFSIZE)) != MTSE_OK) {
-                 sim_debug(DEBUG_DETAIL, dptr, " error %d\n", r);
-                 if (r == MTSE_TMK)
-                     uptr->STATUS |= MARK;
-                 else if (r == MTSE_WRP)
-                     uptr->STATUS |= WPROT;
-                 else if (r == MTSE_EOM)
-                     uptr->STATUS |= EOT;
-                 else if (r == MTSE_UNATT)
-                     uptr->STATUS |= OFFLINE|OPAT;
-                 else
-                     uptr->STATUS |= OPAT;
-                 uptr->STATUS |= TERMINATE;
-                 uptr->STATUS &= ~BUSY;
-                 mta_busy = 0;
-                 chan_set_done(dev);
-                 return SCPE_OK;
-             }
-             uptr->hwmark = reclen;
-             sim_debug(DEBUG_DETAIL, dptr, "Block %d chars\n", reclen);
+         sim_debug(DEBUG_DETAIL, dptr, "Read unit=%d ", unit);
+         if ((r = sim_tape_rdrecf(uptr, &mta_buffer[0], &reclen,
+                          BUFFSIZE)) != MTSE_OK) {
+             sim_debug(DEBUG_DETAIL, dptr, " error %d\n", r);
+             if (r == MTSE_TMK)
+                 uptr->STATUS |= MARK;
+             else if (r == MTSE_WRP)
+                 uptr->STATUS |= WPROT;
+             else if (r == MTSE_EOM)
+                 uptr->STATUS |= EOT;
+             else if (r == MTSE_UNATT)
+                 uptr->STATUS |= OFFLINE|OPAT;
+             else
+                 uptr->STATUS |= OPAT;
+             uptr->STATUS |= TERMINATE;
+             uptr->STATUS &= ~BUSY;
+             mta_busy = 0;
+             chan_set_done(dev);
+             return SCPE_OK;
          }
-         stop = 0;
-         if (uptr->flags & MTUF_9TR) {
-             /* Grab three chars off buffer */
-             word = 0;
-             uptr->STATUS &= ~CMASK;
-             for(i = 16; i >= 0; i-=8) {
-                 if ((uint32)uptr->POS >= uptr->hwmark) {
-                    /* Add in fill characters */
-                    stop = 1;
-                    if (i == 8) {
-                       uptr->STATUS += B2|B1;
-                       word |= 074;
-                    } else if (i == 16) {
-                       uptr->STATUS += B1;
-                       word |= 07474;
-                    }
-                    break;
-                 }
-                 word |= (uint32)mta_buffer[uptr->POS++] << i;
-             }
-             uptr->STATUS |= BM1;
-         } else {
-             /* Grab four chars and check parity */
-             word = 0;
-             mode = (uptr->CMD & BCD) ? 0 : 0100;
-             uptr->STATUS &= ~CMASK;
-             for(i = 18; i >= 0; i-=6) {
-                 if (stop || (uint32)uptr->POS >= uptr->hwmark) {
-                    stop = 1;
-                    ch = 074;
-                 } else {
-                    ch = mta_buffer[uptr->POS++];
-                    if ((parity_table[ch & 077] ^ (ch & 0100) ^ mode) == 0) {
-                        sim_debug(DEBUG_DETAIL, dptr, "Parity error unit=%d %d %03o\n",
-                              unit, uptr->POS-1, ch);
-                        uptr->STATUS |= PARITY;
+         uptr->hwmark = reclen;
+         sim_debug(DEBUG_DETAIL, dptr, "Block %d chars\n", reclen);
+
+         /* Move the whole record into memory */
+         for (;;) {
+             stop = 0;
+             if (uptr->flags & MTUF_9TR) {
+                 /* Grab three chars off buffer */
+                 word = 0;
+                 uptr->STATUS &= ~CMASK;
+                 for(i = 16; i >= 0; i-=8) {
+                     if ((uint32)uptr->POS >= uptr->hwmark) {
+                        /* Add in fill characters */
+                        stop = 1;
+                        if (i == 8) {
+                           uptr->STATUS += B2|B1;
+                           word |= 074;
+                        } else if (i == 16) {
+                           uptr->STATUS += B1;
+                           word |= 07474;
+                        }
                         break;
-                    }
-                    uptr->STATUS += B1;
+                     }
+                     word |= (uint32)mta_buffer[uptr->POS++] << i;
                  }
-                 word |= (ch & 077) << i;
-             }
-         }
-         sim_debug(DEBUG_DATA, dptr, "unit=%d %08o read %08o\n", unit, uptr->ADDR, word);
-         if (stop || (uptr->STATUS & (CMASK|BM1)) != 0) {
-             if (uptr->ADDR < 8)
-                 XR[uptr->ADDR] = word;
-             M[uptr->ADDR++] = word;
-             uptr->ADDR &= M15;
-             uptr->CMD -= 1 << 16;
-             if (stop || (uptr->CMD & (M15 << 16)) == 0 || (uint32)uptr->POS >= uptr->hwmark) {
-                 /* Done with transfer */
-                 sim_debug(DEBUG_DETAIL, dptr, "unit=%d %08o left %08o\n", unit, uptr->ADDR,
-                                    uptr->CMD >> 16);
-                 if ((uptr->CMD & (M15 << 16)) == 0 && (uint32)uptr->POS < uptr->hwmark)
-                     uptr->STATUS |= LONGBLK;
-                 if ((uptr->CMD & BCD) != 0 && (uptr->CMD & (M15 << 16)) != 0
-                                  && (uint32)uptr->POS >= uptr->hwmark) {
-                     uptr->STATUS |= FILLWRD;
-                     M[uptr->ADDR++] = 074747474;
-                     uptr->ADDR &= M15;
+                 uptr->STATUS |= BM1;
+             } else {
+                 /* Grab four chars and check parity */
+                 word = 0;
+                 mode = (uptr->CMD & BCD) ? 0 : 0100;
+                 uptr->STATUS &= ~CMASK;
+                 for(i = 18; i >= 0; i-=6) {
+                     if (stop || (uint32)uptr->POS >= uptr->hwmark) {
+                        stop = 1;
+                        ch = 074;
+                     } else {
+                        ch = mta_buffer[uptr->POS++];
+                        if ((parity_table[ch & 077] ^ (ch & 0100) ^ mode) == 0) {
+                            sim_debug(DEBUG_DETAIL, dptr, "Parity error unit=%d %d %03o\n",
+                                  unit, uptr->POS-1, ch);
+                            uptr->STATUS |= PARITY;
+                            break;
+                        }
+                        uptr->STATUS += B1;
+                     }
+                     word |= (ch & 077) << i;
                  }
-                 uptr->STATUS |= TERMINATE;
-                 uptr->STATUS &= ~BUSY;
-                 M[64 + dev] = uptr->ADDR;  /* Get transfer address */
-                 mta_busy = 0;
+             }
+             sim_debug(DEBUG_DATA, dptr, "unit=%d %08o read %08o\n", unit, uptr->ADDR, word);
+             if (stop || (uptr->STATUS & (CMASK|BM1)) != 0) {
+                 if (uptr->ADDR < 8)
+                     XR[uptr->ADDR] = word;
+                 M[uptr->ADDR++] = word;
+                 uptr->ADDR &= M15;
+                 uptr->CMD -= 1 << 16;
+                 if (stop || (uptr->CMD & (M15 << 16)) == 0 || (uint32)uptr->POS >= uptr->hwmark)
+                     break;
                  uptr->STATUS &= FMASK;
-                 chan_set_done(dev);
-                 return SCPE_OK;
              }
-             uptr->STATUS &= FMASK;
          }
-         sim_activate(uptr, 100);
+
+         /* Done with transfer */
+         sim_debug(DEBUG_DETAIL, dptr, "unit=%d %08o left %08o\n", unit, uptr->ADDR,
+                            uptr->CMD >> 16);
+         if ((uptr->CMD & (M15 << 16)) == 0 && (uint32)uptr->POS < uptr->hwmark)
+             uptr->STATUS |= LONGBLK;
+         if ((uptr->CMD & BCD) != 0 && (uptr->CMD & (M15 << 16)) != 0
+                          && (uint32)uptr->POS >= uptr->hwmark) {
+             uptr->STATUS |= FILLWRD;
+             M[uptr->ADDR++] = 074747474;
+             uptr->ADDR &= M15;
+         }
+         M[64 + dev] = uptr->ADDR;  /* Get transfer address */
+         uptr->STATUS &= FMASK;
+         uptr->CMD |= DONE;
+         sim_activate(uptr, MT_GAP + (MT_CHAR * reclen));
          break;
 
     case MT_WRITEERG: /* Write and Erase */
@@ -349,167 +364,162 @@ t_stat mta_svc (UNIT *uptr)
              return SCPE_OK;
          }
 
-         word = M[uptr->ADDR++];
-         uptr->ADDR &= M15;
-         uptr->CMD -= 1 << 16;
-         sim_debug(DEBUG_DATA, dptr, "unit=%d %08o write %08o\n", unit, uptr->ADDR, word);
-
-         stop = 0;
-         if (uptr->flags & MTUF_9TR) {
-             /* Put three chars in buffer */
-             uptr->STATUS &= ~CMASK;
-             for(i = 16; i >= 0; i-=8) {
-                 mta_buffer[uptr->POS++] = (uint8)((word >> i) & 0xff);
-                 uptr->STATUS += B1;
-             }
-             /* Check if end character detected */
-             if ((uptr->CMD & BCD) != 0) {
-                 for (i = 0; i <= 18; i+= 6) {
-                     if (((word >> i) & 077)  == 074) {
-                         uptr->POS--;
-                         uptr->STATUS -= B1;
-                         stop = 1;
+         /* Gather the whole record from memory */
+         do {
+             word = M[uptr->ADDR++];
+             uptr->ADDR &= M15;
+             uptr->CMD -= 1 << 16;
+             sim_debug(DEBUG_DATA, dptr, "unit=%d %08o write %08o\n", unit, uptr->ADDR, word);
+
+             stop = 0;
+             if (uptr->flags & MTUF_9TR) {
+                 /* Put three chars in buffer */
+                 uptr->STATUS &= ~CMASK;
+                 for(i = 16; i >= 0; i-=8) {
+                     mta_buffer[uptr->POS++] = (uint8)((word >> i) & 0xff);
+                     uptr->STATUS += B1;
+                 }
+                 /* Check if end character detected */
+                 if ((uptr->CMD & BCD) != 0) {
+                     for (i = 0; i <= 18; i+= 6) {
+                         if (((word >> i) & 077)  == 074) {
+                             uptr->POS--;
+                             uptr->STATUS -= B1;
+                             stop = 1;
+                         }
                      }
                  }
-             }
-         } else {
-             /* Put four chars and generate parity */
-             mode = (uptr->CMD & BCD) ? 0 : 0100;
-             uptr->STATUS &= ~CMASK;
-             for(i = 18; i >= 0; i-=6) {
-                 ch = (uint8)((word >> i) & 077);
-                 if ((uptr->CMD & BCD) != 0 && ch == 074) {
-                     stop = 1;
-                     break;
+             } else {
+                 /* Put four chars and generate parity */
+                 mode = (uptr->CMD & BCD) ? 0 : 0100;
+                 uptr->STATUS &= ~CMASK;
+                 for(i = 18; i >= 0; i-=6) {
+                     ch = (uint8)((word >> i) & 077);
+                     if ((uptr->CMD & BCD) != 0 && ch == 074) {
+                         stop = 1;
+                         break;
+                     }
+                     ch |= parity_table[ch] ^ mode;
+                     mta_buffer[uptr->POS++] = ch;
+                     uptr->STATUS += B1;
                  }
-                 ch |= parity_table[ch] ^ mode;
-                 mta_buffer[uptr->POS++] = ch;
-                 uptr->STATUS += B1;
              }
-         }
-         uptr->STATUS &= FMASK;
+             uptr->STATUS &= FMASK;
+         } while (!stop && (uptr->CMD & (M15 << 16)) != 0 &&
+                  uptr->POS <= (BUFFSIZE - 4));
+
+         /* Done with transfer */
          uptr->hwmark = uptr->POS;
-         if (stop || (uptr->CMD & (M15 << 16)) == 0) {
-             /* Done with transfer */
-             reclen = uptr->hwmark;
-             sim_debug(DEBUG_DETAIL, dptr, "Write unit=%d Block %d chars\n",
-                      unit, reclen);
-             r = sim_tape_wrrecf(uptr, &mta_buffer[0], reclen);
-             if (r != MTSE_OK)
-                uptr->STATUS |= OPAT;
-             uptr->STATUS |= TERMINATE;
+         reclen = uptr->hwmark;
+         sim_debug(DEBUG_DETAIL, dptr, "Write unit=%d Block %d chars\n",
+                  unit, reclen);
+         r = sim_tape_wrrecf(uptr, &mta_buffer[0], reclen);
+         if (r != MTSE_OK)
+            uptr->STATUS |= OPAT;
+         M[64 + dev] = uptr->ADDR;  /* Set transfer address */
+         uptr->CMD |= DONE;
+         sim_activate(uptr, MT_GAP + (MT_CHAR * reclen));
+         break;
+
+    case MT_REV_READ:
+         if (sim_tape_bot(uptr)) {
+             uptr->STATUS |= OPAT|TERMINATE;
              uptr->STATUS &= ~BUSY;
              mta_busy = 0;
-             uptr->STATUS &= FMASK;
-             M[64 + dev] = uptr->ADDR;  /* Set transfer address */
              chan_set_done(dev);
              return SCPE_OK;
          }
-         sim_activate(uptr, 100);
-         break;
-
-    case MT_REV_READ:
-         /* If empty buffer, fill */
-         if (BUF_EMPTY(uptr)) {
-             if (sim_tape_bot(uptr)) {
-                 uptr->STATUS |= OPAT|TERMINATE;
-                 uptr->STATUS &= ~BUSY;
-                 mta_busy = 0;
-                 chan_set_done(dev);
-                 return SCPE_OK;
-             }
-             sim_debug(DEBUG_DETAIL, dptr, "Read rev unit=%d ", unit);
-             if ((r = sim_tape_rdrecr(uptr, &mta_buffer[0], &reclen,
-                              BUFFSIZE)) != MTSE_OK) {
-                 sim_debug(DEBUG_DETAIL, dptr, " error %d\n", r);
-                 if (r == MTSE_TMK)
-                     uptr->STATUS |= MARK;
-                 else if (r == MTSE_WRP)
-                     uptr->STATUS |= WPROT;
-                 else if (r == MTSE_EOM)
-                     uptr->STATUS |= EOT;
-                 else if (r == MTSE_UNATT)
-                     uptr->STATUS |= OFFLINE|OPAT;
-                 else
-                     uptr->STATUS |= OPAT;
-                 uptr->STATUS |= TERMINATE;
-                 uptr->STATUS &= ~BUSY;
-                 mta_busy = 0;
-                 chan_set_done(dev);
-                 return SCPE_OK;
-             }
-             uptr->POS = reclen;
-             uptr->ADDR += (uptr->CMD >> 16) + 1;
-             uptr->hwmark = reclen;
-             sim_debug(DEBUG_DETAIL, dptr, "Block %d chars\n", reclen);
+         sim_debug(DEBUG_DETAIL, dptr, "Read rev unit=%d ", unit);
+         if ((r = sim_tape_rdrecr(uptr, &mta_buffer[0], &reclen,
+                          BUFFSIZE)) != MTSE_OK) {
+             sim_debug(DEBUG_DETAIL, dptr, " error %d\n", r);
+             if (r == MTSE_TMK)
+                 uptr->STATUS |= MARK;
+             else if (r == MTSE_WRP)
+                 uptr->STATUS |= WPROT;
+             else if (r == MTSE_EOM)
+                 uptr->STATUS |= EOT;
+             else if (r == MTSE_UNATT)
+                 uptr->STATUS |= OFFLINE|OPAT;
+             else
+                 uptr->STATUS |= OPAT;
+             uptr->STATUS |= TERMINATE;
+             uptr->STATUS &= ~BUSY;
+             mta_busy = 0;
+             chan_set_done(dev);
+             return SCPE_OK;
          }
-
-         stop = 0;
-         if (uptr->flags & MTUF_9TR) {
-             /* Grab three chars off buffer */
-             word = 0;
-             uptr->STATUS &= ~CMASK;
-             for(i = 0; i <= 16; i+=8) {
-                 word |= (uint32)mta_buffer[--uptr->POS] << i;
-                 if (uptr->POS == 0) {
-                    stop = 1;
-                    break;
+         uptr->POS = reclen;
+         uptr->ADDR += (uptr->CMD >> 16) + 1;
+         uptr->hwmark = reclen;
+         sim_debug(DEBUG_DETAIL, dptr, "Block %d chars\n", reclen);
+
+         /* Move the whole record into memory backwards */
+         for (;;) {
+             stop = 0;
+             if (uptr->flags & MTUF_9TR) {
+                 /* Grab three chars off buffer */
+                 word = 0;
+                 uptr->STATUS &= ~CMASK;
+                 for(i = 0; i <= 16; i+=8) {
+                     word |= (uint32)mta_buffer[--uptr->POS] << i;
+                     if (uptr->POS == 0) {
+                        stop = 1;
+                        break;
+                     }
                  }
-             }
-             uptr->STATUS |= BM1;
-         } else {
-             /* Grab four chars and check parity */
-             word = 0;
-             mode = (uptr->CMD & BCD) ? 0 : 0100;
-             uptr->STATUS &= ~CMASK;
-             for(i = 0; i <= 16; i+=6) {
-                 if (uptr->POS == 0) {
-                     ch = 074;
-                     stop = 1;
-                 } else {
-                     ch = mta_buffer[--uptr->POS];
-                     if ((parity_table[ch & 077] ^ (ch & 0100) ^ mode) == 0) {
-                         sim_debug(DEBUG_DETAIL, dptr, "Parity error unit=%d %d %03o\n",
-                               unit, uptr->POS, ch);
-                         uptr->STATUS |= PARITY;
-                         break;
+                 uptr->STATUS |= BM1;
+             } else {
+                 /* Grab four chars and check parity */
+                 word = 0;
+                 mode = (uptr->CMD & BCD) ? 0 : 0100;
+                 uptr->STATUS &= ~CMASK;
+                 for(i = 0; i <= 16; i+=6) {
+                     if (uptr->POS == 0) {
+                         ch = 074;
+                         stop = 1;
+                     } else {
+                         ch = mta_buffer[--uptr->POS];
+                         if ((parity_table[ch & 077] ^ (ch & 0100) ^ mode) == 0) {
+                             sim_debug(DEBUG_DETAIL, dptr, "Parity error unit=%d %d %03o\n",
+                                   unit, uptr->POS, ch);
+                             uptr->STATUS |= PARITY;
+                             break;
+                         }
+                         uptr->STATUS += B1;
                      }
-                     uptr->STATUS += B1;
+                     word |= (ch & 077) << i;
                  }
-                 word |= (ch & 077) << i;
              }
-         }
-         sim_debug(DEBUG_DATA, dptr, "unit=%d %08o read %08o\n", unit, uptr->ADDR, word);
-         if (stop || (uptr->STATUS & (CMASK|BM1)) != 0) {
-             uptr->ADDR = (uptr->ADDR - 1) & M15;
-             if (uptr->ADDR < 8)
-                 XR[uptr->ADDR] = word;
-             M[uptr->ADDR] = word;
-             uptr->CMD -= 1 << 16;
-             if (stop || (uptr->CMD & (M15 << 16)) == 0 || uptr->POS == 0) {
-                 sim_debug(DEBUG_DETAIL, dptr, "unit=%d %08o left %08o\n", unit, uptr->ADDR,
-                                             uptr->CMD >> 16);
-                 /* Done with transfer */
-                 if ((uptr->CMD & (M15 << 16)) == 0 && uptr->POS != 0)
-                     uptr->STATUS |= LONGBLK;
-                 if ((uptr->CMD & BCD) != 0 && (uptr->CMD & (M15 << 16)) != 0
-                                  && uptr->POS != 0) {
-                     uptr->STATUS |= FILLWRD;
-                     uptr->ADDR = (uptr->ADDR - 1) & M15;
-                     M[uptr->ADDR] = 074747474;
-                     uptr->ADDR &= M15;
-                 }
-                 uptr->STATUS |= TERMINATE;
-                 uptr->STATUS &= ~BUSY;
-                 M[64 + dev] = uptr->ADDR;  /* Set transfer address */
-                 mta_busy = 0;
+             sim_debug(DEBUG_DATA, dptr, "unit=%d %08o read %08o\n", unit, uptr->ADDR, word);
+             if (stop || (uptr->STATUS & (CMASK|BM1)) != 0) {
+                 uptr->ADDR = (uptr->ADDR - 1) & M15;
+                 if (uptr->ADDR < 8)
+                     XR[uptr->ADDR] = word;
+                 M[uptr->ADDR] = word;
+                 uptr->CMD -= 1 << 16;
+                 if (stop || (uptr->CMD & (M15 << 16)) == 0 || uptr->POS == 0)
+                     break;
                  uptr->STATUS &= FMASK;
-                 chan_set_done(dev);
-                 return SCPE_OK;
              }
-             uptr->STATUS &= FMASK;
          }
-         sim_activate(uptr, 100);
+
+         /* Done with transfer */
+         sim_debug(DEBUG_DETAIL, dptr, "unit=%d %08o left %08o\n", unit, uptr->ADDR,
+                                     uptr->CMD >> 16);
+         if ((uptr->CMD & (M15 << 16)) == 0 && uptr->POS != 0)
+             uptr->STATUS |= LONGBLK;
+         if ((uptr->CMD & BCD) != 0 && (uptr->CMD & (M15 << 16)) != 0
+                          && uptr->POS != 0) {
+             uptr->STATUS |= FILLWRD;
+             uptr->ADDR = (uptr->ADDR - 1) & M15;
+             M[uptr->ADDR] = 074747474;
+             uptr->ADDR &= M15;
+         }
+         M[64 + dev] = uptr->ADDR;  /* Set transfer address */
+         uptr->STATUS &= FMASK;
+         uptr->CMD |= DONE;
+         sim_activate(uptr, MT_GAP + (MT_CHAR * reclen));
          break;
 
     case MT_SKIPF:
@@ -531,7 +541,7 @@ t_stat mta_svc (UNIT *uptr)
                   sim_activate(uptr, 50);
               } else {
                   sim_debug(DEBUG_DETAIL, dptr, "%d\n", reclen);
-                  sim_activate(uptr, 10 + (10 * reclen));
+                  sim_activate(uptr, MT_GAP + (MT_CHAR * reclen));
               }
               break;
          case 2:
@@ -589,7 +599,7 @@ t_stat mta_svc (UNIT *uptr)
                   sim_activate(uptr, 50);
               } else {
                   sim_debug(DEBUG_DETAIL, dptr, "%d \n", reclen);
-                  sim_activate(uptr, 10 + (10 * reclen));
+                  sim_activate(uptr, MT_GAP + (MT_CHAR * reclen));
               }
               break;
          case 2:
@@ -467,6 +467,130 @@ chan_output_word(int dev, uint32 *data, int eor) {
     return r;
 }
 
+/* Work out how many words can be moved before the control word needs
+   attention.  The last word of a control word, backward transfers, the
+   index register alias and the control word itself are left to get_ccw.
+   Returns a pointer to the store area, or NULL if nothing can be moved
+   in bulk. */
+static uint32 *
+chan_block(int dev, int n, int *cnt) {
+    int      cw_addr;
+    int      cw_len = 1;
+    uint32   cw0;
+    uint32   cw1;
+    uint32   addr;
+    int      c;
+
+    if (io_flags & EXT_IO) {
+        cw_addr = 256+4*dev;
+        cw_len = 2;
+        cw0 = M[cw_addr];
+        cw1 = M[cw_addr+1];
+        if (cw0 & BACKWARD)
+            return NULL;
+        c = cw0 & M15;
+        if (c == 0)
+            c = M15 + 1;
+        addr = cw1 & M22;
+        if (c > (int)(M22 + 1 - addr))
+            c = M22 + 1 - addr;
+    } else {
+        cw_addr = 64+dev;
+        cw0 = M[cw_addr];
+        c = (cw0 & CNTMSK) >> 15;
+        if (c == 0)
+            c = (CNTMSK >> 15) + 1;
+        addr = cw0 & M15;
+        if (c > (int)(M15 + 1 - addr))
+            c = M15 + 1 - addr;
+    }
+    c--;
+    if (c > n)
+        c = n;
+    if ((int)addr < cw_addr + cw_len && (int)addr + c > cw_addr)
+        c = cw_addr - (int)addr;
+    if (addr < 8 || c <= 0)
+        return NULL;
+    /* Advance the control word past the block */
+    if (io_flags & EXT_IO) {
+        cw0 |= WORDCCW;
+        M[cw_addr] = ((cw0 - c) & M15) | (cw0 & CNTMSK);
+        M[cw_addr+1] = ((cw1 + c) & M22) | (cw1 & CMASK);
+    } else {
+        M[cw_addr] = ((cw0 + c) & M15) | ((cw0 - (c << 15)) & CNTMSK);
+    }
+    *cnt = c;
+    return &M[addr];
+}
+
+/* Transfer up to n words between device and memory.  The store area
+   is checked once per control word, the words are then copied without
+   going through get_ccw.  Sets cnt to the number of words moved and
+   returns end of record like chan_input_word. */
+int
+chan_input_block(int dev, uint32 *data, int n, int *cnt) {
+    DIB         *dibp = devs[dev & 077];
+    int          r = 0;
+    int          c;
+    uint32      *mp;
+
+    *cnt = 0;
+    /* Make sure device assigne here */
+    if (dibp == NULL)
+        return -1;
+
+    /* Check if right type */
+    if ((dibp->type & WORD_DEV) == 0)
+        return -2;
+
+    while (r == 0 && *cnt < n) {
+        if ((dibp->type & (LONG_BLK|SPEC_HES)) == 0 &&
+              (mp = chan_block(dev, n - *cnt, &c)) != NULL) {
+            memcpy(mp, &data[*cnt], c * sizeof(uint32));
+            *cnt += c;
+            if (*cnt == n)
+                break;
+        }
+        r = chan_input_word(dev, &data[*cnt], 0);
+        if (r < 0)
+            break;
+        (*cnt)++;
+    }
+    return r;
+}
+
+int
+chan_output_block(int dev, uint32 *data, int n, int *cnt) {
+    DIB         *dibp = devs[dev & 077];
+    int          r = 0;
+    int          c;
+    uint32      *mp;
+
+    *cnt = 0;
+    /* Make sure device assigne here */
+    if (dibp == NULL)
+        return -1;
+
+    /* Check if right type */
+    if ((dibp->type & WORD_DEV) == 0)
+        return -2;
+
+    while (r == 0 && *cnt < n) {
+        if ((dibp->type & (LONG_BLK|SPEC_HES)) == 0 &&
+              (mp = chan_block(dev, n - *cnt, &c)) != NULL) {
+            memcpy(&data[*cnt], mp, c * sizeof(uint32));
+            *cnt += c;
+            if (*cnt == n)
+                break;
+        }
+        r = chan_output_word(dev, &data[*cnt], 0);
+        if (r < 0)
+            break;
+        (*cnt)++;
+    }
+    return r;
+}
+
 void
 chan_set_done(int dev) {
     if (dev < 24)
@@ -644,78 +644,101 @@ void nia_cpy_mac(uint64 word1, uint64 word2, ETH_MAC mac)
     mac[5] = (unsigned char)((word2 >> 20) & 0xff);
 }
 
+/*
+ * Check that a range of words lies in memory.
+ */
+static int nia_mem_ok(t_addr addr, int words)
+{
+    return addr < MEMSIZE && words <= (int)(MEMSIZE - addr);
+}
+
+/*
+ * Ethernet data is packed 4 bytes per word, left justified in the
+ * upper 32 bits of the 36 bit word, so each word converts to or from
+ * one big-endian 32 bit value.
+ */
+#define NIA_UNPACK(w, p)   do { uint32 _v = (uint32)((w) >> 4);      \
+                                (p)[0] = (uint8)(_v >> 24);           \
+                                (p)[1] = (uint8)(_v >> 16);           \
+                                (p)[2] = (uint8)(_v >> 8);            \
+                                (p)[3] = (uint8)_v; } while (0)
+#define NIA_PACK(p)        ((uint64)(((uint32)(p)[0] << 24) | ((uint32)(p)[1] << 16) | \
+                                     ((uint32)(p)[2] << 8)  |  (uint32)(p)[3]) << 4)
+
 /*
  * Copy memory to a packet.
+ * Returns pointer past data copied, or NULL if memory out of bounds.
  */
 uint8 *nia_cpy_to(t_addr addr, uint8 *data, int len)
 {
-    uint64    word;
-    /* Copy full words */
+    uint64   *mp;
+    uint8     last[4];
+
+    if (len <= 0)
+        return data;
+    if (!nia_mem_ok(addr, (len + 3) / 4))
+        return NULL;
+    mp = &M[addr];
+    /* Copy full words, four at a time */
+    while (len >= 16) {
+        NIA_UNPACK(mp[0], &data[0]);
+        NIA_UNPACK(mp[1], &data[4]);
+        NIA_UNPACK(mp[2], &data[8]);
+        NIA_UNPACK(mp[3], &data[12]);
+        mp += 4;
+        data += 16;
+        len -= 16;
+    }
     while (len > 3) {
-        word = M[addr++];
-        *data++ = (uint8)((word >> 28) & 0xff);
-        *data++ = (uint8)((word >> 20) & 0xff);
-        *data++ = (uint8)((word >> 12) & 0xff);
-        *data++ = (uint8)((word >> 4) & 0xff);
-         len -= 4;
+        NIA_UNPACK(*mp, data);
+        mp++;
+        data += 4;
+        len -= 4;
     }
     /* Grab last partial word */
     if (len) {
-        word = M[addr++];
-        switch (len) {
-        case 3:
-                *data++ = (uint8)((word >> 28) & 0xff);
-                *data++ = (uint8)((word >> 20) & 0xff);
-                *data++ = (uint8)((word >> 12) & 0xff);
-                break;
-        case 2:
-                *data++ = (uint8)((word >> 28) & 0xff);
-                *data++ = (uint8)((word >> 20) & 0xff);
-                break;
-        case 1:
-                *data++ = (uint8)((word >> 28) & 0xff);
-                break;
-        }
+        NIA_UNPACK(*mp, last);
+        memcpy(data, last, len);
+        data += len;
     }
     return data;
 }
 
 /*
  * Copy a packet to memory.
+ * Returns pointer past data copied, or NULL if memory out of bounds.
  */
 uint8 *nia_cpy_from(t_addr addr, uint8 *data, int len)
 {
-    uint64    word;
-
-    /* Copy full words */
+    uint64   *mp;
+    uint8     last[4];
+
+    if (len <= 0)
+        return data;
+    if (!nia_mem_ok(addr, (len + 3) / 4))
+        return NULL;
+    mp = &M[addr];
+    /* Copy full words, four at a time */
+    while (len >= 16) {
+        mp[0] = NIA_PACK(&data[0]);
+        mp[1] = NIA_PACK(&data[4]);
+        mp[2] = NIA_PACK(&data[8]);
+        mp[3] = NIA_PACK(&data[12]);
+        mp += 4;
+        data += 16;
+        len -= 16;
+    }
     while (len > 3) {
-        word =  (uint64)(*data++) << 28;
-        word |= (uint64)(*data++) << 20;
-        word |= (uint64)(*data++) << 12;
-        word |= (uint64)(*data++) << 4;
-        M[addr++] = word;
+        *mp++ = NIA_PACK(data);
+        data += 4;
         len -= 4;
     }
     /* Copy last partial word */
     if (len) {
-        switch (len) {
-        case 3:
-                word =  (uint64)(*data++) << 28;
-                word |= (uint64)(*data++) << 20;
-                word |= (uint64)(*data++) << 12;
-                break;
-        case 2:
-                word =  (uint64)(*data++) << 28;
-                word |= (uint64)(*data++) << 20;
-                break;
-        case 1:
-                word =  (uint64)(*data++) << 28;
-                break;
-        default:
-                word = 0;
-                break;
-        }
-        M[addr++] = word;
+        memset(last, 0, sizeof(last));
+        memcpy(last, data, len);
+        *mp = NIA_PACK(last);
+        data += len;
     }
     return data;
 }
@@ -727,28 +750,23 @@ uint8 *nia_cpy_from(t_addr addr, uint8 *data, int len)
  */
 int nia_getq(t_addr head, t_addr *entry)
 {
-    uint64    temp;
     t_addr    flink;
     t_addr    nlink;
     *entry = 0;  /* For safty */
 
-    /* Try and get lock */
-    if (Mem_read_word(head, &temp, 0)) {
+    /* Queue header is interlock, flink, blink */
+    if (!nia_mem_ok(head, 3)) {
         nia_error(EBSERR);
         return 0;
     }
     /* Check if entry locked */
-    if ((temp & SMASK) == 0)
+    if ((M[head] & SMASK) == 0)
         return 0;
 
     /* Increment lock here */
 
     /* Get head of queue */
-    if (Mem_read_word(head + 1, &temp, 0)) {
-        nia_error(EBSERR);
-        return 0;
-    }
-    flink = (t_addr)(temp & AMASK);
+    flink = (t_addr)(M[head + 1] & AMASK);
     /* Check if queue empty */
     if (flink == (head+1)) {
         sim_debug(DEBUG_DETAIL, &nia_dev, "NIA empty %08o\n", head);
@@ -756,25 +774,21 @@ int nia_getq(t_addr head, t_addr *entry)
         return 1;
     }
     /* Get link to next entry */
-    if (Mem_read_word(flink + 1, &temp, 0)) {
+    if (!nia_mem_ok(flink, 2)) {
         nia_error(EBSERR);
         return 0;
     }
-    nlink = (t_addr)(temp & AMASK);
+    nlink = (t_addr)(M[flink + 1] & AMASK);
     sim_debug(DEBUG_DETAIL, &nia_dev, "NIA head: q=%08o f=%08o n=%08o\n",
              head, flink, nlink);
-    /* Set Head Flink to point to next */
-    temp = (uint64)nlink;
-    if (Mem_write_word(head+1, &temp, 0)) {
+    if (!nia_mem_ok(nlink, 2)) {
         nia_error(EBSERR);
         return 0;
     }
+    /* Set Head Flink to point to next */
+    M[head + 1] = (uint64)nlink;
     /* Set Next Blink to head */
-    temp = (uint64)(head + 1);
-    if (Mem_write_word(nlink+1, &temp, 0)) {
-        nia_error(EBSERR);
-        return 0;
-    }
+    M[nlink + 1] = (uint64)(head + 1);
     /* Return entry */
     *entry = flink;
 
@@ -790,52 +804,35 @@ int nia_getq(t_addr head, t_addr *entry)
  */
 int nia_putq(t_addr head, t_addr *entry)
 {
-    uint64    temp;
     t_addr    blink;
 
-    /* Try and get lock */
-    if (Mem_read_word(head, &temp, 0)) {
+    /* Queue header is interlock, flink, blink */
+    if (!nia_mem_ok(head, 3)) {
         nia_error(EBSERR);
         return 0;
     }
     /* Check if entry locked */
-    if ((temp & SMASK) == 0)
+    if ((M[head] & SMASK) == 0)
         return 0;
 
     /* Increment lock here */
 
     /* Hook entry into tail of queue */
-    if (Mem_read_word(head + 2, &temp, 0)) {
+    blink = (t_addr)(M[head + 2] & AMASK);  /* Get back link */
+    if (!nia_mem_ok(blink, 1) || !nia_mem_ok(*entry, 2)) {
         nia_error(EBSERR);
         return 0;
     }
-
-    blink = (t_addr)(temp & AMASK);  /* Get back link */
     /* Get link to previous entry */
-    temp = (uint64)*entry;
-    if (Mem_write_word(blink, &temp, 0)) {
-        nia_error(EBSERR);
-        return 0;
-    }
+    M[blink] = (uint64)*entry;
     /* Old forward is new */
-    if (Mem_write_word(head+2, &temp, 0)) {
-        nia_error(EBSERR);
-        return 0;
-    }
+    M[head + 2] = (uint64)*entry;
 
     /* Flink is head of queue */
-    temp = (uint64)(head+1);
-    if (Mem_write_word(*entry, &temp, 0)) {
-        nia_error(EBSERR);
-        return 0;
-    }
+    M[*entry] = (uint64)(head+1);
 
     /* Back link points to previous */
-    temp = (uint64)blink;
-    if (Mem_write_word(*entry+1, &temp, 0)) {
-        nia_error(EBSERR);
-        return 0;
-    }
+    M[*entry + 1] = (uint64)blink;
     sim_debug(DEBUG_DETAIL, &nia_dev, "NIA put: q=%08o i=%08o b=%08o\n",
                 head, *entry, blink);
     *entry = 0;
@@ -1171,7 +1168,13 @@ int nia_send_pkt(uint64 cmd)
                 return 0;
             }
             blen = (int)(tlen & 0177777);
+            if (blen > len)
+               blen = len;
             data = nia_cpy_to((t_addr)(word2 & AMASK), data, blen);
+            if (data == NULL) {
+                nia_error(EBSERR);
+                return 0;
+            }
             len -= blen;
             if (Mem_read_word((t_addr)((word1 + 1) & AMASK), &word1, 0)) {
                 nia_error(EBSERR);
@@ -1180,6 +1183,10 @@ int nia_send_pkt(uint64 cmd)
         }
     } else {
         data = nia_cpy_to(nia_data.cmd_entry + 9, data, len);
+        if (data == NULL) {
+            nia_error(EBSERR);
+            return 0;
+        }
     }
     if (((cmd & (NIA_FLG_PAD << 8)) != 0) &&
                nia_data.snd_buff.len < ETH_MIN_PACKET) {
@@ -1433,10 +1440,13 @@ nia_rec_pkt()
         nia_error(EBSERR);
         return 0;
     }
-    (void)nia_cpy_from(nia_data.rec_entry + 5,
-                         (uint8 *)&hdr->dest, sizeof(ETH_MAC));
-    (void)nia_cpy_from(nia_data.rec_entry + 7,
-                         (uint8 *)&hdr->src, sizeof(ETH_MAC));
+    if (nia_cpy_from(nia_data.rec_entry + 5,
+                         (uint8 *)&hdr->dest, sizeof(ETH_MAC)) == NULL ||
+        nia_cpy_from(nia_data.rec_entry + 7,
+                         (uint8 *)&hdr->src, sizeof(ETH_MAC)) == NULL) {
+        nia_error(EBSERR);
+        return 0;
+    }
     word = (uint64)(((type & 0xff00) >> 4) |
                            ((type & 0xff) << 12));
     if (Mem_write_word(nia_data.rec_entry + 9, &word, 0)) {
@@ -1464,6 +1474,10 @@ nia_rec_pkt()
             return 0;
         }
         data = nia_cpy_from((t_addr)(word & AMASK), data, blen);
+        if (data == NULL) {
+            nia_error(EBSERR);
+            return 0;
+        }
         len -= blen;
         /* Get pointer to next segment */
         if (Mem_read_word(bsd+1, &word, 0)) {
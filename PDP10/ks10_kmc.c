@@ -1428,21 +1428,20 @@ static t_stat kmc_rxService (UNIT *rxup) {
 
         ba = d->rx.ba;
         sim_debug (DF_PKT, &kmc_dev, "Send to: ");
-        for (i = 0; i < seglen; i++) {
-                sim_debug (DF_PKT, &kmc_dev, "%02x ", d->rxmsg[d->rxused + i]);
-             if (uba_write_npr_byte(ba, kmc_dib.uba_ctl, d->rxmsg[d->rxused + i]) == 0) {
-                 uint16 bd[3];
-                 memcpy(bd, &d->rx.bd, sizeof bd);
-                 d->rx.rcvc += i;
-                 bd[1] = d->rx.rcvc;
-                 kmc_updateBDCount (d->rx.bda, bd);  /* Unchecked because already reporting NXM */
-                 kmc_ctrlOut (k, SEL6_CO_NXM, SEL2_IOT, d->line, d->rx.bda);
-                 d->rxstate = RXIDLE;
-                 goto done;
-             }
-             ba++;
-        }
+        for (i = 0; i < seglen; i++)
+             sim_debug (DF_PKT, &kmc_dev, "%02x ", d->rxmsg[d->rxused + i]);
         sim_debug (DF_PKT, &kmc_dev, "\n");
+        i = uba_write_npr_block(ba, kmc_dib.uba_ctl, &d->rxmsg[d->rxused], seglen);
+        if (i != seglen) {
+             uint16 bd[3];
+             memcpy(bd, &d->rx.bd, sizeof bd);
+             d->rx.rcvc += i;
+             bd[1] = d->rx.rcvc;
+             kmc_updateBDCount (d->rx.bda, bd);  /* Unchecked because already reporting NXM */
+             kmc_ctrlOut (k, SEL6_CO_NXM, SEL2_IOT, d->line, d->rx.bda);
+             d->rxstate = RXIDLE;
+             goto done;
+        }
         d->rx.ba += seglen;
         d->rx.rcvc += seglen;
         d->rxused += seglen;
@@ -2257,14 +2256,12 @@ static t_bool kmc_txAppendBuffer(dupstate *d) {
     }
 
     ba = d->tx.ba;
-    for (i = 0; i < d->tx.bd[1]; i++) {
-       if (uba_read_npr_byte(ba, kmc_dib.uba_ctl, &d->txmsg[d->txmlen+i]) == 0) {
-           d->tx.bd[1] -= i;
-           kmc_updateBDCount (d->tx.bda, d->tx.bd);
-           kmc_ctrlOut (k, SEL6_CO_NXM, 0, d->line, ba);
-           return FALSE;
-       }
-       ba++;
+    i = uba_read_npr_block(ba, kmc_dib.uba_ctl, &d->txmsg[d->txmlen], d->tx.bd[1]);
+    if (i != d->tx.bd[1]) {
+        d->tx.bd[1] -= i;
+        kmc_updateBDCount (d->tx.bda, d->tx.bd);
+        kmc_ctrlOut (k, SEL6_CO_NXM, 0, d->line, ba + i);
+        return FALSE;
     }
     kmc_updateBDCount (d->tx.bda, d->tx.bd);
     d->txmlen += d->tx.bd[1];
@@ -2629,13 +2626,10 @@ static t_bool kmc_printBDL(int32 k, uint32 dbits, DEVICE *dev, uint8 line, int32
             if (bd[1] > sizeof buf)
                 bd[1] = sizeof buf;
 
-            for (i = 0; i < bd[1]; i++) {
-                if (uba_read_npr_byte(dp + i, kmc_dib.uba_ctl,
-                              &buf[i]) == 0) {
-                     kmc_ctrlOut (k, SEL6_CO_NXM, 0, line, dp);
-                     sim_debug (dbits, dev, "KMC%u line %u: NXM reading buffer %06o\n", k, line, dp);
-                     return FALSE;
-                 }
+            if (uba_read_npr_block(dp, kmc_dib.uba_ctl, buf, bd[1]) != bd[1]) {
+                 kmc_ctrlOut (k, SEL6_CO_NXM, 0, line, dp);
+                 sim_debug (dbits, dev, "KMC%u line %u: NXM reading buffer %06o\n", k, line, dp);
+                 return FALSE;
             }
 
             if (prbuf != 5) {                   /* Don't print RX buffer in */
@@ -330,6 +330,116 @@ uba_write_npr_word(t_addr addr, uint16 ctl, uint16 data)
     return 1;
 }
 
+/*
+ * Move a block of bytes between memory and a buffer. The UBA map is
+ * looked up once per page, and whole words are moved at a time when
+ * aligned. Returns number of bytes moved, this is less then len if an
+ * invalid page was hit.
+ */
+int
+uba_read_npr_block(t_addr addr, uint16 ctl, uint8 *data, int len)
+{
+    int     ubm = uba_device[ctl];
+    uint32  map;
+    t_addr  pa;
+    uint64  wd;
+    int     cnt;
+    int     n = 0;
+
+    while (n < len) {
+        if ((addr & 0400000) != 0)
+            break;
+        map = uba_map[ubm][(077) & (addr >> 11)];
+        if ((map & MAP_VALID) == 0)
+            break;
+        /* Transfer up to end of page */
+        cnt = 04000 - (addr & 03777);
+        if (cnt > len - n)
+            cnt = len - n;
+        sim_debug(DEBUG_DATA, &cpu_dev, "RD NPR BLK %08o %06o %d\n", addr,
+                  map & PAGE_MASK, cnt);
+        while (cnt > 0) {
+            pa = (map & PAGE_MASK) | ((addr >> 2) & 0777);
+            wd = M[pa];
+            if ((addr & 03) == 0 && cnt >= 4) {
+                data[n++] = (uint8)((wd >> 18) & 0377);
+                data[n++] = (uint8)((wd >> 26) & 0377);
+                data[n++] = (uint8)(wd & 0377);
+                data[n++] = (uint8)((wd >> 8) & 0377);
+                addr += 4;
+                cnt -= 4;
+                continue;
+            }
+            if ((addr & 02) == 0)
+                wd >>= 18;
+            if ((addr & 01))
+                wd >>= 8;
+            data[n++] = (uint8)(wd & 0377);
+            addr++;
+            cnt--;
+        }
+    }
+    return n;
+}
+
+int
+uba_write_npr_block(t_addr addr, uint16 ctl, uint8 *data, int len)
+{
+    int     ubm = uba_device[ctl];
+    uint32  map;
+    t_addr  pa;
+    uint64  wd;
+    uint64  msk;
+    uint64  buf;
+    int     cnt;
+    int     n = 0;
+
+    while (n < len) {
+        if ((addr & 0400000) != 0)
+            break;
+        map = uba_map[ubm][(077) & (addr >> 11)];
+        if ((map & MAP_VALID) == 0)
+            break;
+        /* Transfer up to end of page */
+        cnt = 04000 - (addr & 03777);
+        if (cnt > len - n)
+            cnt = len - n;
+        sim_debug(DEBUG_DATA, &cpu_dev, "WR NPR BLK %08o %06o %d\n", addr,
+                  map & PAGE_MASK, cnt);
+        while (cnt > 0) {
+            pa = (map & PAGE_MASK) | ((addr >> 2) & 0777);
+            if ((addr & 03) == 0 && cnt >= 4) {
+                buf = ((uint64)data[n]) << 18;
+                buf |= ((uint64)data[n+1]) << 26;
+                buf |= ((uint64)data[n+2]);
+                buf |= ((uint64)data[n+3]) << 8;
+                M[pa] = (M[pa] & ~((0177777LL << 18) | 0177777LL)) | buf;
+                n += 4;
+                addr += 4;
+                cnt -= 4;
+                continue;
+            }
+            msk = 0377;
+            buf = (uint64)data[n++];
+            if ((addr & 02) == 0) {
+                buf <<= 18;
+                msk <<= 18;
+            }
+            if ((addr & 01)) {
+                buf <<= 8;
+                msk <<= 8;
+            }
+            wd = M[pa];
+            wd &= ~msk;
+            wd |= buf;
+            M[pa] = wd;
+            addr++;
+            cnt--;
+        }
+    }
+    return n;
+}
+
 void
 uba_set_irq(DIB *dibp, int vect)
 {
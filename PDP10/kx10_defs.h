@@ -599,6 +599,8 @@ int     uba_read_npr_byte(t_addr addr, uint16 ctl, uint8 *data);
 int     uba_write_npr_byte(t_addr addr, uint16 ctl, uint8 data);
 int     uba_read_npr_word(t_addr addr, uint16 ctl, uint16 *data);
 int     uba_write_npr_word(t_addr addr, uint16 ctl, uint16 data);
+int     uba_read_npr_block(t_addr addr, uint16 ctl, uint8 *data, int len);
+int     uba_write_npr_block(t_addr addr, uint16 ctl, uint8 *data, int len);
 void    uba_set_irq(DIB *dibp, int vect);
 void    uba_clr_irq(DIB *dibp, int vect);
 t_addr  uba_get_vect(t_addr addr, int lvl, int dev);
@@ -66,128 +66,389 @@ static struct disk_formats fmts[] = {
     {0, 0},
 };
 
-t_stat 
-disk_read(UNIT *uptr, uint64 *buffer, int sector, int wps)
+/*
+ *  Each unit keeps a cache of recently used sectors, hung off up8. The
+ *  cache is made of lines of CACHE_SECT consecutive sectors, replaced
+ *  least recently used first. Writes only mark the sector dirty, dirty
+ *  sectors are written back when the line is replaced, when the
+ *  simulator stops, DISK_FLUSH_SEC seconds after the first change and
+ *  on detach. The SCP periodic flush does not call io_flush while
+ *  running with asynchronous I/O, so the timed flush has a unit of its
+ *  own. There is no writer thread, all write back is done synchronously
+ *  in the simulator thread, the timed flush from the INT-DSKFLUSH
+ *  service routine. Runs of dirty sectors are written with one write.
+ */
+
+#define CACHE_SECT      32               /* Sectors per cache line */
+#define CACHE_LINES     32               /* Cache lines per unit */
+#define DISK_FLUSH_SEC  30               /* Seconds before dirty lines written */
+
+struct disk_line {
+    int         blk;                     /* Line number, -1 if empty */
+    uint32      dirty;                   /* Sectors needing write back */
+    uint64      age;                     /* Last time line used */
+    uint64      *data;                   /* Sector data */
+};
+
+struct disk_cache {
+    int         wps;                     /* Words per sector */
+    uint64      clock;                   /* Use counter for LRU */
+    uint8       *conv;                   /* Conversion buffer for line */
+    uint64      hits;                    /* Sectors found in cache */
+    uint64      misses;                  /* Lines read from file */
+    uint64      wr_sect;                 /* Sectors written to file */
+    uint64      wr_ops;                  /* Writes to file */
+    struct disk_line line[CACHE_LINES];
+};
+
+/*
+ *  Convert between 36 bit words and KLH10 packed formats. Each pair of
+ *  words is 72 bits in 9 bytes. The first 8 bytes are assembled into a
+ *  single 64 bit value and the last byte handled on it's own, this lets
+ *  the compiler use one load or store (and byte swap) per pair instead
+ *  of working on a byte at a time. tests/disk9bench.c checks and times
+ *  copies of them against the old byte loops, keep it in step.
+ */
+#define M36             0777777777777LL
+
+static void
+dbd9_unpack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   hi;
+    uint8    *p = conv_buff;
+    int      wp;
+
+    for (wp = 0; wp < nw; wp += 2, p += 9) {
+        hi = ((uint64)p[0] << 56) | ((uint64)p[1] << 48) |
+             ((uint64)p[2] << 40) | ((uint64)p[3] << 32) |
+             ((uint64)p[4] << 24) | ((uint64)p[5] << 16) |
+             ((uint64)p[6] << 8) | ((uint64)p[7]);
+        buffer[wp] = hi >> 28;
+        buffer[wp+1] = ((hi & 01777777777LL) << 8) | (uint64)p[8];
+    }
+}
+
+static void
+dbd9_pack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   hi;
+    uint8    *p = conv_buff;
+    int      wp;
+
+    for (wp = 0; wp < nw; wp += 2, p += 9) {
+        hi = ((buffer[wp] & M36) << 28) | ((buffer[wp+1] & M36) >> 8);
+        p[0] = (uint8)(hi >> 56);
+        p[1] = (uint8)(hi >> 48);
+        p[2] = (uint8)(hi >> 40);
+        p[3] = (uint8)(hi >> 32);
+        p[4] = (uint8)(hi >> 24);
+        p[5] = (uint8)(hi >> 16);
+        p[6] = (uint8)(hi >> 8);
+        p[7] = (uint8)(hi);
+        p[8] = (uint8)(buffer[wp+1] & 0xff);
+    }
+}
+
+static void
+dld9_unpack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   lo;
+    uint8    *p = conv_buff;
+    int      wp;
+
+    for (wp = 0; wp < nw; wp += 2, p += 9) {
+        lo = ((uint64)p[0]) | ((uint64)p[1] << 8) |
+             ((uint64)p[2] << 16) | ((uint64)p[3] << 24) |
+             ((uint64)p[4] << 32) | ((uint64)p[5] << 40) |
+             ((uint64)p[6] << 48) | ((uint64)p[7] << 56);
+        buffer[wp] = lo & M36;
+        buffer[wp+1] = (lo >> 36) | ((uint64)p[8] << 28);
+    }
+}
+
+static void
+dld9_pack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   lo;
+    uint8    *p = conv_buff;
+    int      wp;
+
+    for (wp = 0; wp < nw; wp += 2, p += 9) {
+        lo = (buffer[wp] & M36) | (buffer[wp+1] << 36);
+        p[0] = (uint8)(lo);
+        p[1] = (uint8)(lo >> 8);
+        p[2] = (uint8)(lo >> 16);
+        p[3] = (uint8)(lo >> 24);
+        p[4] = (uint8)(lo >> 32);
+        p[5] = (uint8)(lo >> 40);
+        p[6] = (uint8)(lo >> 48);
+        p[7] = (uint8)(lo >> 56);
+        p[8] = (uint8)((buffer[wp+1] >> 28) & 0xff);
+    }
+}
+
+/* Read count sectors starting at sector from file */
+static void
+disk_rd_blk(UNIT *uptr, uint64 *buffer, int sector, int wps, int count,
+            uint8 *conv_buff)
 {
     int      da;
     int      wc;
     int      bc;
-    int      wp;
-    uint64   temp;
-    uint8    conv_buff[2048];
+    int      nw = wps * count;
+
     switch(GET_FMT(uptr->flags)) {
     case SIMH:
             da = sector * wps;
             (void)sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
-            wc = sim_fread (buffer, sizeof(uint64), wps, uptr->fileref);
-            while (wc < wps)
+            wc = sim_fread (buffer, sizeof(uint64), nw, uptr->fileref);
+            while (wc < nw)
                 buffer[wc++] = 0;
             break;
     case DBD9:
             bc = (wps / 2) * 9;
             da = sector * bc;
+            bc *= count;
             (void)sim_fseek(uptr->fileref, da, SEEK_SET);
-            wc = sim_fread (&conv_buff, 1, bc, uptr->fileref);
+            wc = sim_fread (conv_buff, 1, bc, uptr->fileref);
             while (wc < bc)
                  conv_buff[wc++] = 0;
-            for (wp = wc = 0; wp < wps;) {
-                temp = ((uint64)conv_buff[wc++]) << 28;
-                temp |= ((uint64)conv_buff[wc++]) << 20;
-                temp |= ((uint64)conv_buff[wc++]) << 12;
-                temp |= ((uint64)conv_buff[wc++]) << 4;
-                temp |= ((uint64)conv_buff[wc]) >> 4;
-                buffer[wp++] = temp;
-                temp = ((uint64)conv_buff[wc++] & 0xf) << 32;
-                temp |= ((uint64)conv_buff[wc++]) << 24;
-                temp |= ((uint64)conv_buff[wc++]) << 16;
-                temp |= ((uint64)conv_buff[wc++]) << 8;
-                temp |= ((uint64)conv_buff[wc++]);
-                buffer[wp++] = temp;
-            }
+            dbd9_unpack(buffer, conv_buff, nw);
             break;
 
     case DLD9:
             bc = (wps / 2) * 9;
             da = sector * bc;
+            bc *= count;
             (void)sim_fseek(uptr->fileref, da, SEEK_SET);
-            wc = sim_fread (&conv_buff, 1, bc, uptr->fileref);
+            wc = sim_fread (conv_buff, 1, bc, uptr->fileref);
             while (wc < bc)
                  conv_buff[wc++] = 0;
-            for (wp = wc = 0; wp < wps;) {
-                temp = ((uint64)conv_buff[wc++]);
-                temp |= ((uint64)conv_buff[wc++]) << 8;
-                temp |= ((uint64)conv_buff[wc++]) << 16;
-                temp |= ((uint64)conv_buff[wc++]) << 24;
-                temp |= ((uint64)conv_buff[wc] & 0xf) << 32;
-                buffer[wp++] = temp;
-                temp = ((uint64)conv_buff[wc++] & 0xf0) >> 4;
-                temp |= ((uint64)conv_buff[wc++]) << 4;
-                temp |= ((uint64)conv_buff[wc++]) << 12;
-                temp |= ((uint64)conv_buff[wc++]) << 20;
-                temp |= ((uint64)conv_buff[wc++]) << 28;
-                buffer[wp++] = temp;
-            }
+            dld9_unpack(buffer, conv_buff, nw);
             break;
      }
-     return SCPE_OK;
 }
 
-t_stat
-disk_write(UNIT *uptr, uint64 *buffer, int sector, int wps)
+/* Write count sectors starting at sector to file */
+static void
+disk_wr_blk(UNIT *uptr, uint64 *buffer, int sector, int wps, int count,
+            uint8 *conv_buff)
 {
     int      da;
     int      wc;
     int      bc;
-    int      wp;
-    uint64   temp;
-    uint8    conv_buff[2048];
+    int      nw = wps * count;
+
     switch(GET_FMT(uptr->flags)) {
     case SIMH:
             da = sector * wps;
             (void)sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
-            wc = sim_fwrite (buffer, sizeof(uint64), wps, uptr->fileref);
+            wc = sim_fwrite (buffer, sizeof(uint64), nw, uptr->fileref);
             break;
     case DBD9:
             bc = (wps / 2) * 9;
-            for (wp = wc = 0; wp < wps;) {
-                temp = buffer[wp++];
-                conv_buff[wc++] = (uint8)((temp >> 28) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 20) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 12) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 4) & 0xff);
-                conv_buff[wc] = (uint8)((temp & 0xf) << 4);
-                temp = buffer[wp++];
-                conv_buff[wc++] |= (uint8)((temp >> 32) & 0xf);
-                conv_buff[wc++] = (uint8)((temp >> 24) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 16) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 8) & 0xff);
-                conv_buff[wc++] = (uint8)(temp & 0xff);
-            }
+            dbd9_pack(buffer, conv_buff, nw);
             da = sector * bc;
             (void)sim_fseek(uptr->fileref, da, SEEK_SET);
-            wc = sim_fwrite (&conv_buff, 1, bc, uptr->fileref);
-            return SCPE_OK;
+            wc = sim_fwrite (conv_buff, 1, bc * count, uptr->fileref);
+            break;
     case DLD9:
             bc = (wps / 2) * 9;
-            for (wp = wc = 0; wp < wps;) {
-                temp = buffer[wp++];
-                conv_buff[wc++] = (uint8)(temp & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 8) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 16) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 24) & 0xff);
-                conv_buff[wc] = (uint8)((temp >> 32)  & 0xf);
-                temp = buffer[wp++];
-                conv_buff[wc++] |= (uint8)((temp << 4) & 0xf0);
-                conv_buff[wc++] = (uint8)((temp >> 4) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 12) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 20) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 28) & 0xff);
-            }
+            dld9_pack(buffer, conv_buff, nw);
             da = sector * bc;
             (void)sim_fseek(uptr->fileref, da, SEEK_SET);
-            wc = sim_fwrite (&conv_buff, 1, bc, uptr->fileref);
-            return SCPE_OK;
+            wc = sim_fwrite (conv_buff, 1, bc * count, uptr->fileref);
+            break;
+    }
+}
+
+static t_stat disk_flush_svc(UNIT *uptr);
+
+static UNIT disk_flush_unit = { UDATA (&disk_flush_svc, UNIT_IDLE, 0) };
+static DEVICE disk_flush_dev = {
+    "INT-DSKFLUSH", &disk_flush_unit, NULL, NULL,
+    1, 0, 0, 0, 0, 0,
+    NULL, NULL, NULL, NULL, NULL, NULL,
+    NULL, DEV_NOSAVE, 0,
+    NULL, NULL, NULL, NULL, NULL, NULL,
+    NULL};
+
+/* Write back dirty sectors of a line */
+static void
+disk_flush_line(UNIT *uptr, struct disk_cache *c, struct disk_line *l)
+{
+    int      s, n;
+
+    for (s = 0; l->dirty != 0; s += n) {
+        while ((l->dirty & (1u << s)) == 0)
+            s++;
+        for (n = 0; s + n < CACHE_SECT && (l->dirty & (1u << (s + n))); n++)
+            l->dirty &= ~(1u << (s + n));
+        disk_wr_blk(uptr, &l->data[s * c->wps], l->blk * CACHE_SECT + s,
+                    c->wps, n, c->conv);
+        c->wr_sect += n;
+        c->wr_ops++;
+    }
+}
+
+/* Free cache of unit, caller must flush it first */
+static void
+disk_free_cache(UNIT *uptr)
+{
+    struct disk_cache *c = (struct disk_cache *)uptr->up8;
+    int      i;
+
+    if (c == NULL)
+        return;
+    for (i = 0; i < CACHE_LINES; i++)
+        free(c->line[i].data);
+    free(c->conv);
+    free(c);
+    uptr->up8 = NULL;
+}
+
+/* Find cache for unit, create it on first access */
+static struct disk_cache *
+disk_get_cache(UNIT *uptr, int wps)
+{
+    struct disk_cache *c = (struct disk_cache *)uptr->up8;
+    int      i;
+
+    if (c != NULL && c->wps == wps)
+        return c;
+    disk_flush(uptr);
+    disk_free_cache(uptr);
+    if ((c = (struct disk_cache *)calloc(1, sizeof(struct disk_cache))) == NULL)
+        return NULL;
+    if ((c->conv = (uint8 *)malloc(CACHE_SECT * (wps / 2) * 9)) == NULL) {
+        free(c);
+        return NULL;
+    }
+    c->wps = wps;
+    for (i = 0; i < CACHE_LINES; i++)
+        c->line[i].blk = -1;
+    uptr->up8 = c;
+    return c;
+}
+
+/* Find line holding sector, read it in if not in cache */
+static struct disk_line *
+disk_get_line(UNIT *uptr, struct disk_cache *c, int sector)
+{
+    struct disk_line *l;
+    struct disk_line *lru = &c->line[0];
+    int      blk = sector / CACHE_SECT;
+    int      i;
+
+    for (i = 0; i < CACHE_LINES; i++) {
+        l = &c->line[i];
+        if (l->blk == blk) {
+            c->hits++;
+            l->age = ++c->clock;
+            return l;
+        }
+        if (l->age < lru->age)
+            lru = l;
+    }
+    if (lru->data == NULL) {
+        lru->data = (uint64 *)malloc(CACHE_SECT * c->wps * sizeof(uint64));
+        if (lru->data == NULL)
+            return NULL;
+    }
+    disk_flush_line(uptr, c, lru);
+    c->misses++;
+    lru->blk = blk;
+    lru->age = ++c->clock;
+    disk_rd_blk(uptr, lru->data, blk * CACHE_SECT, c->wps, CACHE_SECT, c->conv);
+    return lru;
+}
+
+t_stat 
+disk_read(UNIT *uptr, uint64 *buffer, int sector, int wps)
+{
+    struct disk_cache *c;
+    struct disk_line  *l;
+    uint8    conv_buff[2048];
+
+    if ((c = disk_get_cache(uptr, wps)) != NULL &&
+        (l = disk_get_line(uptr, c, sector)) != NULL) {
+        memcpy(buffer, &l->data[(sector % CACHE_SECT) * wps],
+               wps * sizeof(uint64));
+        return SCPE_OK;
+    }
+    disk_rd_blk(uptr, buffer, sector, wps, 1, conv_buff);
+    return SCPE_OK;
+}
+
+t_stat
+disk_write(UNIT *uptr, uint64 *buffer, int sector, int wps)
+{
+    struct disk_cache *c;
+    struct disk_line  *l;
+    uint8    conv_buff[2048];
+
+    if (uptr->flags & UNIT_RO)
+        return SCPE_RO;
+    if ((c = disk_get_cache(uptr, wps)) != NULL &&
+        (l = disk_get_line(uptr, c, sector)) != NULL) {
+        memcpy(&l->data[(sector % CACHE_SECT) * wps], buffer,
+               wps * sizeof(uint64));
+        l->dirty |= 1u << (sector % CACHE_SECT);
+        if (!sim_is_active(&disk_flush_unit))
+            sim_activate_after(&disk_flush_unit, DISK_FLUSH_SEC * 1000000);
+        return SCPE_OK;
+    }
+    disk_wr_blk(uptr, buffer, sector, wps, 1, conv_buff);
+    return SCPE_OK;
+}
+
+/* Write back all dirty sectors of unit */
+void
+disk_flush(UNIT *uptr)
+{
+    struct disk_cache *c = (struct disk_cache *)uptr->up8;
+    int      i;
+
+    if (c == NULL)
+        return;
+    for (i = 0; i < CACHE_LINES; i++)
+        disk_flush_line(uptr, c, &c->line[i]);
+    if (uptr->fileref != NULL)
+        fflush(uptr->fileref);
+}
+
+/* Timed write back of all cached units */
+static t_stat
+disk_flush_svc(UNIT *uptr)
+{
+    DEVICE   *dptr;
+    UNIT     *u;
+    uint32   i, j;
+
+    for (i = 0; (dptr = sim_devices[i]) != NULL; i++) {
+        for (j = 0; j < dptr->numunits; j++) {
+            u = &dptr->units[j];
+            if ((u->flags & UNIT_ATT) && u->io_flush == &disk_flush)
+                disk_flush(u);
+        }
+    }
+    return SCPE_OK;
+}
+
+/* Show cache statistics */
+t_stat disk_show_cache (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
+{
+    struct disk_cache *c = (struct disk_cache *)uptr->up8;
+    uint64   total;
+
+    if (c == NULL) {
+        fprintf (st, "cache empty");
+        return SCPE_OK;
     }
+    total = c->hits + c->misses;
+    fprintf (st, "cache hits=%llu misses=%llu (%d%% hit), written %llu sectors in %llu writes",
+             c->hits, c->misses, (total == 0) ? 0 : (int)((c->hits * 100) / total),
+             c->wr_sect, c->wr_ops);
     return SCPE_OK;
 }
 
@@ -247,6 +508,8 @@ t_stat disk_attach (UNIT *uptr, CONST char *cptr)
     r = attach_unit (uptr, cptr);
     if (r != SCPE_OK)
         return r;
+    uptr->io_flush = &disk_flush;
+    sim_register_internal_device(&disk_flush_dev);
     return SCPE_OK;
 }
 
@@ -254,6 +517,9 @@ t_stat disk_attach (UNIT *uptr, CONST char *cptr)
 
 t_stat disk_detach (UNIT *uptr)
 {
+    disk_flush (uptr);
+    disk_free_cache (uptr);
+    uptr->io_flush = NULL;
     return detach_unit (uptr);
 }
 
@@ -285,5 +551,8 @@ t_stat disk_attach_help(FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const ch
     fprintf (st, "                is SIMH), other options are DBD9 and DLD9\n");
     fprintf (st, "    -Y          Answer Yes to prompt to overwrite last track (on disk create)\n");
     fprintf (st, "    -N          Answer No to prompt to overwrite last track (on disk create)\n");
+    fprintf (st, "\nRecently used sectors are cached in memory, changed sectors are written\n");
+    fprintf (st, "back within %d seconds, when the simulator stops and on detach.\n", DISK_FLUSH_SEC);
+    fprintf (st, "SHOW %s CACHE displays cache statistics.\n", dptr->name);
     return SCPE_OK;
 }
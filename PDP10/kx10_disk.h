@@ -66,6 +66,10 @@
 
 t_stat disk_read(UNIT *uptr, uint64 *buffer, int sector, int wps);
 t_stat disk_write(UNIT *uptr, uint64 *buffer, int sector, int wps);
+/* Write back cached sectors */
+void disk_flush(UNIT *uptr);
+/* Show cache statistics */
+t_stat disk_show_cache (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
 /* Set disk format */
 t_stat disk_set_fmt (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 /* Show disk format */
@@ -281,6 +281,8 @@ MTAB                dp_mod[] = {
     {UNIT_DTYPE, (RP02_DTYPE << UNIT_V_DTYPE), "RP02", "RP02", &dp_set_type },
     {UNIT_DTYPE, (RP01_DTYPE << UNIT_V_DTYPE), "RP01", "RP01", &dp_set_type },
     {MTAB_XTD|MTAB_VUN, 0, "FORMAT", "FORMAT", NULL, &disk_show_fmt }, 
+    {MTAB_XTD|MTAB_VUN, 0, "CACHE", NULL, NULL, &disk_show_cache, NULL,
+              "Display disk cache statistics" },
     {0},
 };
 
@@ -186,7 +186,13 @@
 
 
 #define IMP_ARPTAB_SIZE        64
+#define IMP_ARPHASH_BITS       6                /* log2 of ARP hash chains */
 #define IMP_ARP_MAX_AGE        100
+#define IMP_ARP_WHEEL          (IMP_ARP_MAX_AGE + 1) /* ARP aging wheel slots */
+#define IMP_PORTMAP_SIZE       512              /* Adjusted TCP connections */
+#define IMP_PORTHASH_BITS      8                /* log2 of port map hash chains */
+#define IMP_CLS_TIME           100              /* Ticks to keep a closed connection */
+#define IMP_CLS_WHEEL          128              /* Close timer slots, > IMP_CLS_TIME */
 
 uint32 mask[] = {
      0xFFFFFFFF, 0xFFFFFFFE, 0xFFFFFFFC, 0xFFFFFFF8,
@@ -306,6 +312,10 @@ struct arp_entry {
     ETH_MAC    ethaddr;
     int16      age;
 #define ARP_DONT_AGE -1
+    uint32     stamp;                          /* ARP clock when last updated */
+    struct arp_entry *hnext;                   /* Next entry on hash chain */
+    struct arp_entry *wnext;                   /* Next entry in aging wheel slot */
+    struct arp_entry *wprev;                   /* Previous entry in aging wheel slot */
 };
 
 /* DHCP client states */
@@ -424,9 +434,13 @@ struct imp_packet {
 struct imp_map {
     uint16            sport;                   /* Port to fix */
     uint16            dport;                   /* Port to fix */
-    uint16            cls_tim;                 /* Close timer */
+    uint16            cls_tim;                 /* Close timer running */
+    uint16            cls_slot;                /* Close timer wheel slot */
     uint32            adj;                     /* Amount to adjust */
     uint32            lseq;                    /* Sequence number last adjusted */
+    struct imp_map   *hnext;                   /* Next map on hash chain or free list */
+    struct imp_map   *wnext;                   /* Next map in close timer slot */
+    struct imp_map   *wprev;                   /* Previous map in close timer slot */
 };
 
 
@@ -457,7 +471,11 @@ struct imp_device {
     in_addr_T         hostip;                  /* IP address of local host */
     in_addr_T         gwip;                    /* Gateway IP address */
     int               maskbits;                /* Mask length */
-    struct imp_map    port_map[64];            /* Ports to adjust */
+    struct imp_map    port_map[IMP_PORTMAP_SIZE]; /* Ports to adjust */
+    struct imp_map   *port_hash[1 << IMP_PORTHASH_BITS]; /* Port map hash chains */
+    struct imp_map   *port_free;               /* Unused port map entries */
+    struct imp_map   *port_wheel[IMP_CLS_WHEEL]; /* Close timer wheel */
+    uint32            port_tick;               /* Close timer clock */
     in_addr_T         dhcpip;                  /* DHCP server address */
     uint8             dhcp_state;              /* State of DHCP */
     uint32            dhcp_lease;              /* DHCP lease time */
@@ -482,6 +500,9 @@ struct imp_device {
     int               rfnm_count;              /* Number of pending RFNM packets */
     int               pia;                     /* PIA channels */
     struct arp_entry  arp_table[IMP_ARPTAB_SIZE];
+    struct arp_entry *arp_hash[1 << IMP_ARPHASH_BITS]; /* ARP hash chains */
+    struct arp_entry *arp_wheel[IMP_ARP_WHEEL]; /* ARP aging wheel */
+    uint32            arp_clock;               /* ARP aging clock, in seconds */
 } imp_data;
 
 extern int32 tmxr_poll;
@@ -521,6 +542,13 @@ void           imp_packet_in(struct imp_device *imp);
 void           imp_send_packet (struct imp_device *imp_data, int len);
 void           imp_free_packet(struct imp_device *imp, struct imp_packet *p);
 struct imp_packet * imp_get_packet(struct imp_device *imp);
+void           imp_port_clear(struct imp_device *imp);
+struct imp_map * imp_port_lookup(struct imp_device *imp, uint16 sport, uint16 dport);
+struct imp_map * imp_port_alloc(struct imp_device *imp, uint16 sport, uint16 dport);
+void           imp_port_free(struct imp_device *imp, struct imp_map *map);
+void           imp_port_close(struct imp_device *imp, struct imp_map *map);
+void           imp_port_cancel_close(struct imp_device *imp, struct imp_map *map);
+void           imp_arp_clear(struct imp_device *imp);
 void           imp_arp_update(struct imp_device *imp, in_addr_T ipaddr, ETH_MAC ethaddr, int age);
 void           imp_arp_arpin(struct imp_device *imp, ETH_PACK *packet);
 void           imp_arp_arpout(struct imp_device *imp, in_addr_T ipaddr);
@@ -1218,78 +1246,93 @@ t_stat imp_srv(UNIT * uptr)
     return SCPE_OK;
 }
 
+/*
+ * One's complement sum of "len" bytes at "ptr", not yet folded.
+ *
+ * The Internet checksum does not depend on byte order (RFC 1071), so
+ * the data is added in host order, 32 bits at a time, into a 64 bit
+ * accumulator. The folded result is stored back in host order, which
+ * puts the bytes in network order. tests/impcksum.c checks copies of
+ * this and checksumadjust against RFC 1071, keep it in step.
+ */
+static t_uint64
+ip_sum(t_uint64 sum, const uint8 *ptr, int len)
+{
+    uint32   w[4];
+    uint16   h;
+
+    while (len >= 16) {
+        memcpy(w, ptr, 16);
+        sum += (t_uint64)w[0] + w[1] + w[2] + w[3];
+        ptr += 16;
+        len -= 16;
+    }
+    while (len >= 4) {
+        memcpy(w, ptr, 4);
+        sum += w[0];
+        ptr += 4;
+        len -= 4;
+    }
+    if (len >= 2) {
+        memcpy(&h, ptr, 2);
+        sum += h;
+        ptr += 2;
+        len -= 2;
+    }
+    /* Add left-over byte, if any, as the first byte of a word */
+    if (len > 0) {
+        h = 0;
+        memcpy(&h, ptr, 1);
+        sum += h;
+    }
+    return sum;
+}
+
+/*
+ * Fold a one's complement sum to 16 bits.
+ */
+static uint16
+ip_sum_fold(t_uint64 sum)
+{
+    while (sum >> 16)
+        sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16)sum;
+}
+
 void
 ip_checksum(uint8 *chksum, uint8 *ptr, int len)
 {
-   /*
-    * Compute Internet Checksum for "count" bytes
-    *         beginning at location "addr".
-    */
-   int32  sum = 0;
-
-   while( len > 1 )  {
-      /*  This is the inner loop */
-      sum += (ptr[0]<<8)+ptr[1];
-      ptr+=2;
-      len -= 2;
-   }
-
-   /*  Add left-over byte, if any */
-   if( len > 0 )
-      sum += ptr[0]<<8;
+    /*
+     * Compute Internet Checksum for "len" bytes
+     *         beginning at location "ptr".
+     */
+    uint16   sum = ~ip_sum_fold(ip_sum(0, ptr, len));
 
-    /*  Fold 32-bit sum to 16 bits */
-    while (sum>>16)
-       sum = (sum & 0xffff) + (sum >> 16);
-    sum=(~sum & 0xffff);
-    chksum[0]=(sum>>8) & 0xff;
-    chksum[1]=sum & 0xff;
+    memcpy(chksum, &sum, 2);
 }
 
 
 /*
- * Update the checksum based on code from RFC1631
+ * Update the checksum for data replaced in the packet, using the
+ * incremental update of RFC1624: HC' = ~(~HC + ~m + m').
+ *   - chksum points to the chksum in the packet
+ *   - optr points to the old data, olen bytes
+ *   - nptr points to the new data, nlen bytes
+ *   - data starts on an even offset from the start of the checksummed area.
  */
 void
 checksumadjust(uint8 *chksum, uint8 *optr,
    int olen, uint8 *nptr, int nlen)
-   /* assuming: unsigned char is 8 bits, long is 32 bits.
-     - chksum points to the chksum in the packet
-     - optr points to the old data in the packet
-     - nptr points to the new data in the packet
-     - even number of octets updated.
-   */
 {
-    int32 sum, old, new_sum;
-    sum=(chksum[0]<<8)+chksum[1];
-    sum=(~sum & 0xffff);
-    while (olen > 1) {
-        old=(optr[0]<<8)+optr[1];
-        optr+=2;
-        sum-=old & 0xffff;
-        if (sum<=0) { sum--; sum&=0xffff; }
-        olen-=2;
-    }
-    if (olen > 0) {
-        old=optr[0]<<8;
-        sum-=old & 0xffff;
-        if (sum<=0) { sum--; sum&=0xffff; }
-    }
-    while (nlen > 1) {
-        new_sum=(nptr[0]<<8)+nptr[1];
-        nptr+=2;
-        sum+=new_sum & 0xffff;
-        if (sum & 0x10000) { sum++; sum&=0xffff; }
-        nlen-=2;
-    }
-    if (nlen > 0) {
-        new_sum=(nptr[0]<<8);
-        sum+=new_sum & 0xffff;
-        if (sum & 0x10000) { sum++; sum&=0xffff; }
-    }
-    sum=(~sum & 0xffff);
-    chksum[0]=sum>>8;
-    chksum[1]=sum & 0xff;
+    uint16   hc;
+    t_uint64 sum;
+
+    memcpy(&hc, chksum, 2);
+    sum = (uint16)~hc;
+    sum += (uint16)~ip_sum_fold(ip_sum(0, optr, olen));
+    sum = ip_sum(sum, nptr, nlen);
+    hc = ~ip_sum_fold(sum);
+    memcpy(chksum, &hc, 2);
 }
 
 t_stat imp_eth_srv(UNIT * uptr)
@@ -1337,18 +1380,14 @@ void
 imp_timer_task(struct imp_device *imp)
 {
     struct imp_packet  *nq = NULL;                /* New send queue */
-    int                 n;
-
-    /* Scan through adjusted ports and remove old ones */
-    for (n = 0; n < 64; n++) {
-        if (imp->port_map[n].cls_tim > 0) {
-            if (--imp->port_map[n].cls_tim == 0) {
-                imp->port_map[n].dport = 0;
-                imp->port_map[n].sport = 0;
-                imp->port_map[n].adj = 0;
-            }
-        }
-    }
+    struct imp_map     *map;
+    int                 slot;
+
+    /* Remove adjusted ports whose close timer ran out this tick */
+    imp->port_tick++;
+    slot = imp->port_tick & (IMP_CLS_WHEEL - 1);
+    while ((map = imp->port_wheel[slot]) != NULL)
+        imp_port_free(imp, map);
 
     /* Scan the send queue and see if any packets have timed out */
     while (imp->sendq != NULL) {
@@ -1368,6 +1407,127 @@ imp_timer_task(struct imp_device *imp)
      imp->sendq = nq;
 }
 
+/*
+ * Adjusted TCP connections are kept in a hash table keyed on the port
+ * pair, with closing connections on a timing wheel of timer ticks.
+ */
+void
+imp_port_clear(struct imp_device *imp)
+{
+    int                 i;
+
+    memset(imp->port_map, 0, sizeof(imp->port_map));
+    memset(imp->port_hash, 0, sizeof(imp->port_hash));
+    memset(imp->port_wheel, 0, sizeof(imp->port_wheel));
+    imp->port_free = NULL;
+    for (i = IMP_PORTMAP_SIZE - 1; i >= 0; i--) {
+        imp->port_map[i].hnext = imp->port_free;
+        imp->port_free = &imp->port_map[i];
+    }
+}
+
+static int
+imp_port_hash(uint16 sport, uint16 dport)
+{
+    uint32              key = ((uint32)sport << 16) | dport;
+
+    return (int)((key * 0x9E3779B1) >> (32 - IMP_PORTHASH_BITS));
+}
+
+struct imp_map *
+imp_port_lookup(struct imp_device *imp, uint16 sport, uint16 dport)
+{
+    struct imp_map     *map;
+
+    for (map = imp->port_hash[imp_port_hash(sport, dport)]; map != NULL;
+                  map = map->hnext) {
+        if (map->sport == sport && map->dport == dport)
+            return map;
+    }
+    return NULL;
+}
+
+/*
+ * Find the map for a connection, creating one if needed. Returns NULL
+ * if the table is full.
+ */
+struct imp_map *
+imp_port_alloc(struct imp_device *imp, uint16 sport, uint16 dport)
+{
+    struct imp_map     *map;
+    int                 h;
+
+    if ((map = imp_port_lookup(imp, sport, dport)) != NULL)
+        return map;
+    if ((map = imp->port_free) == NULL) {
+        sim_debug(DEBUG_DETAIL, &imp_dev, "IMP port map full %d %d\n",
+                  sport, dport);
+        return NULL;
+    }
+    imp->port_free = map->hnext;
+    memset(map, 0, sizeof(*map));
+    map->sport = sport;
+    map->dport = dport;
+    h = imp_port_hash(sport, dport);
+    map->hnext = imp->port_hash[h];
+    imp->port_hash[h] = map;
+    return map;
+}
+
+void
+imp_port_free(struct imp_device *imp, struct imp_map *map)
+{
+    struct imp_map    **pp;
+
+    imp_port_cancel_close(imp, map);
+    for (pp = &imp->port_hash[imp_port_hash(map->sport, map->dport)];
+                  *pp != NULL; pp = &(*pp)->hnext) {
+        if (*pp == map) {
+            *pp = map->hnext;
+            break;
+        }
+    }
+    map->sport = 0;
+    map->dport = 0;
+    map->adj = 0;
+    map->hnext = imp->port_free;
+    imp->port_free = map;
+}
+
+/*
+ * Start (or restart) the close timer for a connection.
+ */
+void
+imp_port_close(struct imp_device *imp, struct imp_map *map)
+{
+    int                 slot;
+
+    imp_port_cancel_close(imp, map);
+    slot = (imp->port_tick + IMP_CLS_TIME) & (IMP_CLS_WHEEL - 1);
+    map->cls_tim = 1;
+    map->cls_slot = slot;
+    map->wprev = NULL;
+    map->wnext = imp->port_wheel[slot];
+    if (map->wnext != NULL)
+        map->wnext->wprev = map;
+    imp->port_wheel[slot] = map;
+}
+
+void
+imp_port_cancel_close(struct imp_device *imp, struct imp_map *map)
+{
+    if (!map->cls_tim)
+        return;
+    if (map->wprev != NULL)
+        map->wprev->wnext = map->wnext;
+    else
+        imp->port_wheel[map->cls_slot] = map->wnext;
+    if (map->wnext != NULL)
+        map->wnext->wprev = map->wprev;
+    map->wnext = map->wprev = NULL;
+    map->cls_tim = 0;
+}
+
 t_stat imp_tim_srv(UNIT * uptr)
 {
     sim_activate_after(uptr, 1000000);              /* come back once per second */
@@ -1470,34 +1630,28 @@ imp_packet_in(struct imp_device *imp)
                    uint16       sport = ntohs(tcp_hdr->tcp_sport);
                    int          thl = ((ntohs(tcp_hdr->flags) >> 12) & 0xf) * 4;
                    int          hl = (ip_hdr->ip_v_hl & 0xf) * 4;
+                   struct imp_map *map;
                    uint8       *tcp_payload = &imp->rbuffer[
                             sizeof(struct imp_eth_hdr) + hl + thl];
                    checksumadjust((uint8 *)&tcp_hdr->chksum,
                               (uint8 *)(&ip_hdr->ip_dst), sizeof(in_addr_T),
                               (uint8 *)(&imp_data.hostip), sizeof(in_addr_T));
-                   if ((ntohs(tcp_hdr->flags) & TCP_FL_ACK) != 0) {
-                       for (n = 0; n < 64; n++) {
-                           if (imp->port_map[n].sport == sport &&
-                               imp->port_map[n].dport == dport) {
-                               /* Check if SYN */
-                               if (ntohs(tcp_hdr->flags) & TCP_FL_SYN) {
-                                   imp->port_map[n].sport = 0;
-                                   imp->port_map[n].dport = 0;
-                                   imp->port_map[n].adj = 0;
-                               } else {
-                                   uint32   new_seq = ntohl(tcp_hdr->ack);
-                                   if (new_seq > imp->port_map[n].lseq) {
-                                       new_seq = htonl(new_seq - imp->port_map[n].adj);
-                                       checksumadjust((uint8 *)&tcp_hdr->chksum,
-                                               (uint8 *)(&tcp_hdr->ack), 4,
-                                               (uint8 *)(&new_seq), 4);
-                                       tcp_hdr->ack = new_seq;
-                                   }
-                               }
-                               if (ntohs(tcp_hdr->flags) & TCP_FL_FIN)
-                                   imp->port_map[n].cls_tim = 100;
-                               break;
+                   if ((ntohs(tcp_hdr->flags) & TCP_FL_ACK) != 0 &&
+                       (map = imp_port_lookup(imp, sport, dport)) != NULL) {
+                       /* Check if SYN */
+                       if (ntohs(tcp_hdr->flags) & TCP_FL_SYN) {
+                           imp_port_free(imp, map);
+                       } else {
+                           uint32   new_seq = ntohl(tcp_hdr->ack);
+                           if (new_seq > map->lseq) {
+                               new_seq = htonl(new_seq - map->adj);
+                               checksumadjust((uint8 *)&tcp_hdr->chksum,
+                                       (uint8 *)(&tcp_hdr->ack), 4,
+                                       (uint8 *)(&new_seq), 4);
+                               tcp_hdr->ack = new_seq;
                            }
+                           if (ntohs(tcp_hdr->flags) & TCP_FL_FIN)
+                               imp_port_close(imp, map);
                        }
                     }
                     /* Check if receiving to FTP */
@@ -1527,23 +1681,11 @@ imp_packet_in(struct imp_device *imp)
                        memcpy(tcp_payload, port_buffer, nlen);
                        /* Check if we need to update the sequence numbers */
                        if (nlen != l && (ntohs(tcp_hdr->flags) & TCP_FL_SYN) == 0) {
-                           int n = -1;
                            /* See if we need to change the sequence number */
-                           for (i = 0; i < 64; i++) {
-                               if (imp->port_map[i].sport == sport &&
-                                   imp->port_map[i].dport == dport) {
-                                   n = i;
-                                   break;
-                               }
-                               if (n < 0 && imp->port_map[i].dport == 0)
-                                   n = 0;
-                           }
-                           if (n >= 0) {
-                               imp->port_map[n].dport = dport;
-                               imp->port_map[n].sport = sport;
-                               imp->port_map[n].adj += nlen - l;
-                               imp->port_map[n].cls_tim = 0;
-                               imp->port_map[n].lseq = ntohl(tcp_hdr->seq);
+                           if ((map = imp_port_alloc(imp, sport, dport)) != NULL) {
+                               map->adj += nlen - l;
+                               map->lseq = ntohl(tcp_hdr->seq);
+                               imp_port_cancel_close(imp, map);
                            }
                        }
                        /* Now we need to update the checksums */
@@ -1708,6 +1850,7 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
     struct ip_hdr     *pkt = (struct ip_hdr *)(&packet->msg[0]);
     struct imp_packet *send;
     struct arp_entry  *tabptr;
+    struct imp_map    *map;
     in_addr_T          ipaddr;
     int                i;
 
@@ -1729,27 +1872,21 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
                        (uint8 *)(&pkt->iphdr.ip_src), sizeof(in_addr_T),
                        (uint8 *)(&imp->ip), sizeof(in_addr_T));
            /* See if we need to change the sequence number */
-           for (i = 0; i < 64; i++) {
-               if (imp->port_map[i].sport == sport &&
-                   imp->port_map[i].dport == dport) {
-                   /* Check if SYN */
-                   if (ntohs(tcp_hdr->flags) & TCP_FL_SYN) {
-                       imp->port_map[i].sport = 0;
-                       imp->port_map[i].dport = 0;
-                       imp->port_map[i].adj = 0;
-                   } else {
-                       uint32   new_seq = ntohl(tcp_hdr->seq);
-                       if (new_seq > imp->port_map[i].lseq) {
-                           new_seq = htonl(new_seq + imp->port_map[i].adj);
-                           checksumadjust((uint8 *)&tcp_hdr->chksum,
-                                   (uint8 *)(&tcp_hdr->seq), 4,
-                                   (uint8 *)(&new_seq), 4);
-                           tcp_hdr->seq = new_seq;
-                       }
+           if ((map = imp_port_lookup(imp, sport, dport)) != NULL) {
+               /* Check if SYN */
+               if (ntohs(tcp_hdr->flags) & TCP_FL_SYN) {
+                   imp_port_free(imp, map);
+               } else {
+                   uint32   new_seq = ntohl(tcp_hdr->seq);
+                   if (new_seq > map->lseq) {
+                       new_seq = htonl(new_seq + map->adj);
+                       checksumadjust((uint8 *)&tcp_hdr->chksum,
+                               (uint8 *)(&tcp_hdr->seq), 4,
+                               (uint8 *)(&new_seq), 4);
+                       tcp_hdr->seq = new_seq;
                    }
                    if (ntohs(tcp_hdr->flags) & TCP_FL_FIN)
-                       imp->port_map[i].cls_tim = 100;
-                   break;
+                       imp_port_close(imp, map);
                }
            }
            /* Check if sending to FTP */
@@ -1776,23 +1913,11 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
                memcpy(tcp_payload, port_buffer, nlen);
                /* Check if we need to update the sequence numbers */
                if (nlen != l && (ntohs(tcp_hdr->flags) & TCP_FL_SYN) == 0) {
-                   int n = -1;
                    /* See if we need to change the sequence number */
-                   for (i = 0; i < 64; i++) {
-                       if (imp->port_map[i].sport == sport &&
-                           imp->port_map[i].dport == dport) {
-                           n = i;
-                           break;
-                       }
-                       if (n < 0 && imp->port_map[i].dport == 0)
-                           n = 0;
-                   }
-                   if (n >= 0) {
-                       imp->port_map[n].dport = dport;
-                       imp->port_map[n].sport = sport;
-                       imp->port_map[n].adj += nlen - l;
-                       imp->port_map[n].cls_tim = 0;
-                       imp->port_map[n].lseq = ntohl(tcp_hdr->seq);
+                   if ((map = imp_port_alloc(imp, sport, dport)) != NULL) {
+                       map->adj += nlen - l;
+                       map->lseq = ntohl(tcp_hdr->seq);
+                       imp_port_cancel_close(imp, map);
                    }
                }
                /* Now we need to update the checksums */
@@ -1844,16 +1969,13 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
     if ((imp->ip & imp->ip_mask) != (ipaddr & imp->ip_mask))
         ipaddr = imp->gwip;
 
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
-        if (ipaddr == tabptr->ipaddr) {
-            memcpy(&pkt->ethhdr.dest, &tabptr->ethaddr, 6);
-            memcpy(&pkt->ethhdr.src, &imp->mac, 6);
-            pkt->ethhdr.type = htons(ETHTYPE_IP);
-            imp_write(imp, packet);
-            imp->rfnm_count++;
-            return;
-         }
+    if ((tabptr = imp_arp_lookup(imp, ipaddr)) != NULL) {
+        memcpy(&pkt->ethhdr.dest, &tabptr->ethaddr, 6);
+        memcpy(&pkt->ethhdr.src, &imp->mac, 6);
+        pkt->ethhdr.type = htons(ETHTYPE_IP);
+        imp_write(imp, packet);
+        imp->rfnm_count++;
+        return;
     }
 
     /* Queue packet for later send */
@@ -2125,6 +2247,75 @@ void imp_write(struct imp_device *imp, ETH_PACK *packet) {
     eth_write(&imp->etherface, packet, NULL);
 }
 
+/*
+ * Hash an IP address to an ARP hash chain.
+ */
+static int
+imp_arp_hash(in_addr_T ipaddr)
+{
+    return (int)(((uint32)ipaddr * 0x9E3779B1) >> (32 - IMP_ARPHASH_BITS));
+}
+
+/*
+ * Put an entry in the aging wheel slot for the current ARP clock.
+ */
+static void
+imp_arp_wheel_add(struct imp_device *imp, struct arp_entry *tabptr)
+{
+    int                slot = imp->arp_clock % IMP_ARP_WHEEL;
+
+    tabptr->stamp = imp->arp_clock;
+    tabptr->wprev = NULL;
+    tabptr->wnext = imp->arp_wheel[slot];
+    if (tabptr->wnext != NULL)
+        tabptr->wnext->wprev = tabptr;
+    imp->arp_wheel[slot] = tabptr;
+}
+
+static void
+imp_arp_wheel_remove(struct imp_device *imp, struct arp_entry *tabptr)
+{
+    if (tabptr->wprev != NULL)
+        tabptr->wprev->wnext = tabptr->wnext;
+    else
+        imp->arp_wheel[tabptr->stamp % IMP_ARP_WHEEL] = tabptr->wnext;
+    if (tabptr->wnext != NULL)
+        tabptr->wnext->wprev = tabptr->wprev;
+    tabptr->wnext = tabptr->wprev = NULL;
+}
+
+/*
+ * Remove an entry from the ARP table.
+ */
+static void
+imp_arp_remove(struct imp_device *imp, struct arp_entry *tabptr)
+{
+    struct arp_entry **pp;
+
+    if (tabptr->age != ARP_DONT_AGE)
+        imp_arp_wheel_remove(imp, tabptr);
+    for (pp = &imp->arp_hash[imp_arp_hash(tabptr->ipaddr)]; *pp != NULL;
+                   pp = &(*pp)->hnext) {
+        if (*pp == tabptr) {
+            *pp = tabptr->hnext;
+            break;
+        }
+    }
+    memset(tabptr, 0, sizeof(*tabptr));
+}
+
+/*
+ * Empty the ARP table.
+ */
+void
+imp_arp_clear(struct imp_device *imp)
+{
+    memset(imp->arp_table, 0, sizeof(imp->arp_table));
+    memset(imp->arp_hash, 0, sizeof(imp->arp_hash));
+    memset(imp->arp_wheel, 0, sizeof(imp->arp_wheel));
+    imp->arp_clock = 0;
+}
+
 /*
  * Update the ARP table, first use free entry, else use oldest.
  */
@@ -2135,25 +2326,27 @@ imp_arp_update(struct imp_device *imp, in_addr_T ipaddr, ETH_MAC ethaddr, int ag
     int                i;
     char               mac_buf[20];
 
-    /* Check if entry already in the table. */
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
+    /* Address zero marks an unused entry. */
+    if (ipaddr == 0)
+        return;
 
-        if (tabptr->ipaddr != 0) {
-            if (tabptr->ipaddr == ipaddr) {
-                if (0 != eth_mac_cmp(tabptr->ethaddr, ethaddr)) {
-                    eth_copy_mac(tabptr->ethaddr, ethaddr);
-                    eth_mac_fmt(ethaddr, mac_buf);
-                    sim_debug(DEBUG_ARP, &imp_dev,
-                              "updating entry for IP %s to %s\n",
-                              ipv4_inet_ntoa(*((struct in_addr *)&ipaddr)), mac_buf);
-                    }
-                if (tabptr->age != ARP_DONT_AGE)
-                    tabptr->age = age;
-                return;
+    /* Check if entry already in the table. */
+    if ((tabptr = imp_arp_lookup(imp, ipaddr)) != NULL) {
+        if (0 != eth_mac_cmp(tabptr->ethaddr, ethaddr)) {
+            eth_copy_mac(tabptr->ethaddr, ethaddr);
+            eth_mac_fmt(ethaddr, mac_buf);
+            sim_debug(DEBUG_ARP, &imp_dev,
+                      "updating entry for IP %s to %s\n",
+                      ipv4_inet_ntoa(*((struct in_addr *)&ipaddr)), mac_buf);
             }
+        if (tabptr->age != ARP_DONT_AGE) {
+            imp_arp_wheel_remove(imp, tabptr);
+            tabptr->age = age;
+            if (age != ARP_DONT_AGE)
+                imp_arp_wheel_add(imp, tabptr);
         }
-     }
+        return;
+    }
 
     /* See if we can find an unused entry. */
     for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
@@ -2163,24 +2356,28 @@ imp_arp_update(struct imp_device *imp, in_addr_T ipaddr, ETH_MAC ethaddr, int ag
             break;
     }
 
-    /* If no empty entry search for oldest one. */
+    /* If no empty entry, take the oldest one off the aging wheel. */
     if (tabptr->ipaddr != 0) {
-        int       fnd = 0;
-        int16     tmpage = 0;
-        for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-            tabptr = &imp->arp_table[i];
-            if (tabptr->age > tmpage) {
-                tmpage = tabptr->age;
-                fnd = i;
+        tabptr = &imp->arp_table[0];
+        for (i = 1; i <= IMP_ARP_WHEEL; i++) {
+            struct arp_entry *oldest = imp->arp_wheel[(imp->arp_clock + i) % IMP_ARP_WHEEL];
+            if (oldest != NULL) {
+                tabptr = oldest;
+                break;
             }
         }
-        tabptr = &imp->arp_table[fnd];
+        imp_arp_remove(imp, tabptr);
     }
 
     /* Now save the entry */
     eth_copy_mac(tabptr->ethaddr, ethaddr);
     tabptr->ipaddr = ipaddr;
     tabptr->age = age;
+    i = imp_arp_hash(ipaddr);
+    tabptr->hnext = imp->arp_hash[i];
+    imp->arp_hash[i] = tabptr;
+    if (age != ARP_DONT_AGE)
+        imp_arp_wheel_add(imp, tabptr);
     eth_mac_fmt(ethaddr, mac_buf);
     sim_debug(DEBUG_ARP, &imp_dev,
               "creating entry for IP %s to %s, initial age=%d\n",
@@ -2193,24 +2390,19 @@ imp_arp_update(struct imp_device *imp, in_addr_T ipaddr, ETH_MAC ethaddr, int ag
 void imp_arp_age(struct imp_device *imp)
 {
     struct arp_entry  *tabptr;
-    int                i;
+    int                slot;
 
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
-        if (tabptr->ipaddr != 0) {      /* active entry? */
-            if (tabptr->age != ARP_DONT_AGE)
-                tabptr->age++;          /* Age it */
-            /* expire too old entries */
-            if (tabptr->age > IMP_ARP_MAX_AGE) {
-                char mac_buf[20];
-
-                eth_mac_fmt(tabptr->ethaddr, mac_buf);
-                sim_debug(DEBUG_ARP, &imp_dev,
-                          "discarding ARP entry for IP %s %s after %d seconds\n",
-                          ipv4_inet_ntoa(*((struct in_addr *)&tabptr->ipaddr)), mac_buf, IMP_ARP_MAX_AGE);
-                memset(tabptr, 0, sizeof(*tabptr));
-            }
-        }
+    /* Entries in this slot were last updated IMP_ARP_WHEEL seconds ago */
+    imp->arp_clock++;
+    slot = imp->arp_clock % IMP_ARP_WHEEL;
+    while ((tabptr = imp->arp_wheel[slot]) != NULL) {
+        char mac_buf[20];
+
+        eth_mac_fmt(tabptr->ethaddr, mac_buf);
+        sim_debug(DEBUG_ARP, &imp_dev,
+                  "discarding ARP entry for IP %s %s after %d seconds\n",
+                  ipv4_inet_ntoa(*((struct in_addr *)&tabptr->ipaddr)), mac_buf, IMP_ARP_MAX_AGE);
+        imp_arp_remove(imp, tabptr);
     }
 }
 
@@ -2327,16 +2519,11 @@ imp_arp_arpout(struct imp_device *imp, in_addr_T ipaddr)
 struct arp_entry *imp_arp_lookup(struct imp_device *imp, in_addr_T ipaddr)
 {
     struct arp_entry  *tabptr;
-    int                i;
-
-    /* Check if entry already in the table. */
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
 
-        if (tabptr->ipaddr != 0) {
-            if (tabptr->ipaddr == ipaddr)
-                return tabptr;
-        }
+    for (tabptr = imp->arp_hash[imp_arp_hash(ipaddr)]; tabptr != NULL;
+                   tabptr = tabptr->hnext) {
+        if (tabptr->ipaddr == ipaddr)
+            return tabptr;
     }
     return NULL;
 }
@@ -2385,7 +2572,7 @@ t_stat imp_show_arp (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
         else
             fprintf (st, "%-17s%-19s%d\n",
                           ipv4_inet_ntoa(*((struct in_addr *)&tabptr->ipaddr)),
-                          buf, tabptr->age);
+                          buf, (int)(imp_data.arp_clock - tabptr->stamp));
         }
     return SCPE_OK;
 }
@@ -3101,7 +3288,7 @@ t_stat imp_reset (DEVICE *dptr)
         /* Set a default MAC address in a BBN assigned OID range no longer in use */
         imp_set_mac (dptr->units, 0, "00:00:02:00:00:00/24", NULL);
         /* Clear ARP table. */
-        memset(imp_data.arp_table, 0, sizeof(imp_data.arp_table));
+        imp_arp_clear(&imp_data);
         imp_data.dhcp_state = DHCP_STATE_OFF;
     }
     /* Clear queues. */
@@ -3192,7 +3379,8 @@ t_stat imp_attach(UNIT* uptr, CONST char* cptr)
     imp_data.dhcp_xid = (imp_data.mac[0] | (imp_data.mac[1] << 8) |
                         (imp_data.mac[2] << 16) | (imp_data.mac[3] << 24)) + (uint32)time(NULL);
     imp_data.dhcp_state = DHCP_STATE_OFF;
-    memset(imp_data.arp_table, 0, sizeof(imp_data.arp_table));
+    imp_arp_clear(&imp_data);
+    imp_port_clear(&imp_data);
 
     /* If we're not doing DHCP and a gateway is defined on the network
        then define a static APR entry for the gateway to facilitate
@@ -22,6 +22,7 @@
 */
 
 #include "kx10_defs.h"
+#include "kx10_disk.h"
 
 #ifndef NUM_DEVS_RS
 #define NUM_DEVS_RS 0
@@ -226,6 +227,9 @@ MTAB                rs_mod[] = {
         &set_writelock, NULL,   NULL, "Write lock drive" },
     {UNIT_DTYPE, (RS03_DTYPE << UNIT_V_DTYPE), "RS03", "RS03", &rs_set_type },
     {UNIT_DTYPE, (RS04_DTYPE << UNIT_V_DTYPE), "RS04", "RS04", &rs_set_type },
+    {MTAB_XTD|MTAB_VUN, 0, "FORMAT", "FORMAT", NULL, &disk_show_fmt },
+    {MTAB_XTD|MTAB_VUN, 0, "CACHE", NULL, NULL, &disk_show_cache, NULL,
+              "Display disk cache statistics" },
     {0}
 };
 
@@ -480,7 +484,6 @@ t_stat rs_svc (UNIT *uptr)
     case FNC_READ:                       /* read */
     case FNC_WCHK:                       /* write check */
         if (BUF_EMPTY(uptr)) {
-            int wc;
             if (GET_SC(uptr->DA) >= rs_drv_tab[dtype].sect ||
                 GET_SF(uptr->DA) >= rs_drv_tab[dtype].surf) {
                 uptr->CMD |= (ER1_IAE << 16)|DS_ERR|DS_DRY|DS_ATA;
@@ -491,12 +494,8 @@ t_stat rs_svc (UNIT *uptr)
             }
             sim_debug(DEBUG_DETAIL, dptr, "%s%o read (%d,%d)\n", dptr->name, unit,
                    GET_SC(uptr->DA), GET_SF(uptr->DA));
-            da = GET_DA(uptr->DA, dtype) * RS_NUMWD;
-            (void)sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
-            wc = sim_fread (&rs_buf[ctlr][0], sizeof(uint64), RS_NUMWD,
-                                uptr->fileref);
-            while (wc < RS_NUMWD)
-                rs_buf[ctlr][wc++] = 0;
+            da = GET_DA(uptr->DA, dtype);
+            (void)disk_read(uptr, &rs_buf[ctlr][0], da, RS_NUMWD);
             uptr->hwmark = RS_NUMWD;
             uptr->DATAPTR = 0;
         }
@@ -556,10 +555,8 @@ rd_end:
         if (uptr->DATAPTR == RS_NUMWD) {
             sim_debug(DEBUG_DETAIL, dptr, "%s%o write (%d,%d)\n", dptr->name, unit,
                    GET_SC(uptr->DA), GET_SF(uptr->DA));
-            da = GET_DA(uptr->DA, dtype) * RS_NUMWD;
-            (void)sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
-            (void)sim_fwrite (&rs_buf[ctlr][0], sizeof(uint64), RS_NUMWD,
-                                uptr->fileref);
+            da = GET_DA(uptr->DA, dtype);
+            (void)disk_write(uptr, &rs_buf[ctlr][0], da, RS_NUMWD);
             uptr->DATAPTR = 0;
             CLR_BUF(uptr);
             if (sts) {
@@ -631,8 +628,7 @@ rs_boot(int32 unit_num, DEVICE * rptr)
 
     dptr = rs_devs[ctlr];
     rhc = &rs_rh[ctlr];
-    (void)sim_fseek(uptr->fileref, 0, SEEK_SET);
-    (void)sim_fread (&rs_buf[0][0], sizeof(uint64), RS_NUMWD, uptr->fileref);
+    (void)disk_read(uptr, &rs_buf[0][0], 0, RS_NUMWD);
     uptr->CMD |= DS_VV;
     addr = rs_buf[0][ptr] & RMASK;
     wc = (rs_buf[0][ptr++] >> 18) & RMASK;
@@ -667,7 +663,7 @@ t_stat rs_attach (UNIT *uptr, CONST char *cptr)
     int ctlr;
 
     uptr->capac = rs_drv_tab[GET_DTYPE (uptr->flags)].size;
-    r = attach_unit (uptr, cptr);
+    r = disk_attach (uptr, cptr);
     if (r != SCPE_OK)
         return r;
     rstr = find_dev_from_unit(uptr);
@@ -699,7 +695,7 @@ t_stat rs_detach (UNIT *uptr)
     if (sim_is_active (uptr))                              /* unit active? */
         sim_cancel (uptr);                                  /* cancel operation */
     uptr->CMD &= ~(DS_VV|DS_WRL|DS_DPR|DS_DRY);
-    return detach_unit (uptr);
+    return disk_detach (uptr);
 }
 
 t_stat rs_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr)
@@ -709,6 +705,7 @@ fprintf (st, "The RS controller implements the Massbus family of fast disk drive
 fprintf (st, "options include the ability to set units write enabled or write locked, to\n");
 fprintf (st, "set the drive type to one of six disk types or autosize, and to write a DEC\n");
 fprintf (st, "standard 044 compliant bad block table on the last track.\n\n");
+disk_attach_help(st, dptr, uptr, flag, cptr);
 fprint_set_help (st, dptr);
 fprint_show_help (st, dptr);
 fprintf (st, "\nThe type options can be used only when a unit is not attached to a file.\n");
@@ -516,6 +516,8 @@ static msgfn output[] = {
 static void output_data(int port, int n)
 {
     uint64 data;
+    uint8 buf[0177];
+    size_t len = 0, sent;
     int i = 2, c;
 
     sim_debug(DEBUG_DATA, &tym_dev,
@@ -532,12 +534,21 @@ static void output_data(int port, int n)
             data <<= 8;
             sim_debug(DEBUG_DATA, &tym_dev,
                       "Host: send port %d %03o '%c'.\n", port, c, c);
-            tmxr_putc_ln(&tym_ldsc[port], c);
-            tmxr_poll_tx(&tym_desc);
+            buf[len++] = c;
         }
         i = 0;
         next(OBP, OSIZ);
     }
+
+    /* Hand the whole message to the line, pushing it out whenever the
+       buffer fills.  If nothing more goes the rest is dropped, as the
+       failing tmxr_putc_ln calls used to do. */
+    for (i = 0; len > 0; len -= sent, i += sent) {
+        tmxr_put_buf_ln(&tym_ldsc[port], &buf[i], len, &sent);
+        tmxr_poll_tx(&tym_desc);
+        if (sent == 0)
+            break;
+    }
 }
 
 static void tym_output(void)
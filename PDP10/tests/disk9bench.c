@@ -0,0 +1,286 @@
+/*
+ * DBD9/DLD9 conversion benchmark for kx10_disk.c:
+ * cc -O2 -o disk9bench disk9bench.c
+ *
+ * ./disk9bench [passes]
+ *
+ * Runs the byte at a time loops kx10_disk.c used before the converters
+ * were rewritten, and the word pair converters it uses now, on the
+ * same 128 word sectors.  Every result is checked against the old code
+ * first (exit status 1 on any difference), then each converter is timed
+ * and the time per sector printed.
+ *
+ * The new_* functions are copies of dbd9_unpack, dbd9_pack, dld9_unpack
+ * and dld9_pack in kx10_disk.c; keep them the same.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef unsigned long long uint64;
+typedef unsigned char uint8;
+
+#define M36             0777777777777LL
+#define WPS             128             /* words per sector */
+#define BPS             (WPS / 2 * 9)   /* bytes per sector */
+#define NSECT           64              /* sectors per pass */
+
+/* The old loops, from disk_read and disk_write */
+
+static void
+old_dbd9_unpack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   temp;
+    int      wp, wc;
+
+    for (wp = wc = 0; wp < nw;) {
+        temp = ((uint64)conv_buff[wc++]) << 28;
+        temp |= ((uint64)conv_buff[wc++]) << 20;
+        temp |= ((uint64)conv_buff[wc++]) << 12;
+        temp |= ((uint64)conv_buff[wc++]) << 4;
+        temp |= ((uint64)conv_buff[wc]) >> 4;
+        buffer[wp++] = temp;
+        temp = ((uint64)conv_buff[wc++] & 0xf) << 32;
+        temp |= ((uint64)conv_buff[wc++]) << 24;
+        temp |= ((uint64)conv_buff[wc++]) << 16;
+        temp |= ((uint64)conv_buff[wc++]) << 8;
+        temp |= ((uint64)conv_buff[wc++]);
+        buffer[wp++] = temp;
+    }
+}
+
+static void
+old_dbd9_pack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   temp;
+    int      wp, wc;
+
+    for (wp = wc = 0; wp < nw;) {
+        temp = buffer[wp++];
+        conv_buff[wc++] = (uint8)((temp >> 28) & 0xff);
+        conv_buff[wc++] = (uint8)((temp >> 20) & 0xff);
+        conv_buff[wc++] = (uint8)((temp >> 12) & 0xff);
+        conv_buff[wc++] = (uint8)((temp >> 4) & 0xff);
+        conv_buff[wc] = (uint8)((temp & 0xf) << 4);
+        temp = buffer[wp++];
+        conv_buff[wc++] |= (uint8)((temp >> 32) & 0xf);
+        conv_buff[wc++] = (uint8)((temp >> 24) & 0xff);
+        conv_buff[wc++] = (uint8)((temp >> 16) & 0xff);
+        conv_buff[wc++] = (uint8)((temp >> 8) & 0xff);
+        conv_buff[wc++] = (uint8)(temp & 0xff);
+    }
+}
+
+static void
+old_dld9_unpack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   temp;
+    int      wp, wc;
+
+    for (wp = wc = 0; wp < nw;) {
+        temp = ((uint64)conv_buff[wc++]);
+        temp |= ((uint64)conv_buff[wc++]) << 8;
+        temp |= ((uint64)conv_buff[wc++]) << 16;
+        temp |= ((uint64)conv_buff[wc++]) << 24;
+        temp |= ((uint64)conv_buff[wc] & 0xf) << 32;
+        buffer[wp++] = temp;
+        temp = ((uint64)conv_buff[wc++] & 0xf0) >> 4;
+        temp |= ((uint64)conv_buff[wc++]) << 4;
+        temp |= ((uint64)conv_buff[wc++]) << 12;
+        temp |= ((uint64)conv_buff[wc++]) << 20;
+        temp |= ((uint64)conv_buff[wc++]) << 28;
+        buffer[wp++] = temp;
+    }
+}
+
+static void
+old_dld9_pack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   temp;
+    int      wp, wc;
+
+    for (wp = wc = 0; wp < nw;) {
+        temp = buffer[wp++];
+        conv_buff[wc++] = (uint8)(temp & 0xff);
+        conv_buff[wc++] = (uint8)((temp >> 8) & 0xff);
+        conv_buff[wc++] = (uint8)((temp >> 16) & 0xff);
+        conv_buff[wc++] = (uint8)((temp >> 24) & 0xff);
+        conv_buff[wc] = (uint8)((temp >> 32)  & 0xf);
+        temp = buffer[wp++];
+        conv_buff[wc++] |= (uint8)((temp << 4) & 0xf0);
+        conv_buff[wc++] = (uint8)((temp >> 4) & 0xff);
+        conv_buff[wc++] = (uint8)((temp >> 12) & 0xff);
+        conv_buff[wc++] = (uint8)((temp >> 20) & 0xff);
+        conv_buff[wc++] = (uint8)((temp >> 28) & 0xff);
+    }
+}
+
+/* The converters in kx10_disk.c */
+
+static void
+new_dbd9_unpack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   hi;
+    uint8    *p = conv_buff;
+    int      wp;
+
+    for (wp = 0; wp < nw; wp += 2, p += 9) {
+        hi = ((uint64)p[0] << 56) | ((uint64)p[1] << 48) |
+             ((uint64)p[2] << 40) | ((uint64)p[3] << 32) |
+             ((uint64)p[4] << 24) | ((uint64)p[5] << 16) |
+             ((uint64)p[6] << 8) | ((uint64)p[7]);
+        buffer[wp] = hi >> 28;
+        buffer[wp+1] = ((hi & 01777777777LL) << 8) | (uint64)p[8];
+    }
+}
+
+static void
+new_dbd9_pack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   hi;
+    uint8    *p = conv_buff;
+    int      wp;
+
+    for (wp = 0; wp < nw; wp += 2, p += 9) {
+        hi = ((buffer[wp] & M36) << 28) | ((buffer[wp+1] & M36) >> 8);
+        p[0] = (uint8)(hi >> 56);
+        p[1] = (uint8)(hi >> 48);
+        p[2] = (uint8)(hi >> 40);
+        p[3] = (uint8)(hi >> 32);
+        p[4] = (uint8)(hi >> 24);
+        p[5] = (uint8)(hi >> 16);
+        p[6] = (uint8)(hi >> 8);
+        p[7] = (uint8)(hi);
+        p[8] = (uint8)(buffer[wp+1] & 0xff);
+    }
+}
+
+static void
+new_dld9_unpack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   lo;
+    uint8    *p = conv_buff;
+    int      wp;
+
+    for (wp = 0; wp < nw; wp += 2, p += 9) {
+        lo = ((uint64)p[0]) | ((uint64)p[1] << 8) |
+             ((uint64)p[2] << 16) | ((uint64)p[3] << 24) |
+             ((uint64)p[4] << 32) | ((uint64)p[5] << 40) |
+             ((uint64)p[6] << 48) | ((uint64)p[7] << 56);
+        buffer[wp] = lo & M36;
+        buffer[wp+1] = (lo >> 36) | ((uint64)p[8] << 28);
+    }
+}
+
+static void
+new_dld9_pack(uint64 *buffer, uint8 *conv_buff, int nw)
+{
+    uint64   lo;
+    uint8    *p = conv_buff;
+    int      wp;
+
+    for (wp = 0; wp < nw; wp += 2, p += 9) {
+        lo = (buffer[wp] & M36) | (buffer[wp+1] << 36);
+        p[0] = (uint8)(lo);
+        p[1] = (uint8)(lo >> 8);
+        p[2] = (uint8)(lo >> 16);
+        p[3] = (uint8)(lo >> 24);
+        p[4] = (uint8)(lo >> 32);
+        p[5] = (uint8)(lo >> 40);
+        p[6] = (uint8)(lo >> 48);
+        p[7] = (uint8)(lo >> 56);
+        p[8] = (uint8)((buffer[wp+1] >> 28) & 0xff);
+    }
+}
+
+typedef void (*conv)(uint64 *, uint8 *, int);
+
+static struct test {
+    const char *name;
+    conv        old, new;
+    int         pack;
+} tests[] = {
+    { "DBD9 unpack", old_dbd9_unpack, new_dbd9_unpack, 0 },
+    { "DBD9 pack",   old_dbd9_pack,   new_dbd9_pack,   1 },
+    { "DLD9 unpack", old_dld9_unpack, new_dld9_unpack, 0 },
+    { "DLD9 pack",   old_dld9_pack,   new_dld9_pack,   1 },
+};
+
+static uint64 words[NSECT * WPS];
+static uint8 bytes[NSECT * BPS];
+static uint64 wout[2][NSECT * WPS];
+static uint8 bout[2][NSECT * BPS];
+
+static uint64 seed = 1;
+
+static uint64
+rnd(void)
+{
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return seed >> 11;
+}
+
+/* ns per sector for passes over all the sectors */
+static double
+run(conv f, int pack, long passes)
+{
+    clock_t start;
+    long i;
+    int s;
+
+    start = clock();
+    for (i = 0; i < passes; i++) {
+        for (s = 0; s < NSECT; s++) {
+            if (pack)
+                f(&words[s * WPS], &bout[0][s * BPS], WPS);
+            else
+                f(&wout[0][s * WPS], &bytes[s * BPS], WPS);
+        }
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC * 1e9 /
+           ((double)passes * NSECT);
+}
+
+int
+main(int argc, char **argv)
+{
+    long passes = argc > 1 ? atol(argv[1]) : 20000;
+    unsigned t;
+    int i;
+
+    /* Stray bits above bit 35 must pack the same as before */
+    for (i = 0; i < NSECT * WPS; i++)
+        words[i] = (i & 7) ? rnd() & M36 : rnd();
+    for (i = 0; i < NSECT * BPS; i++)
+        bytes[i] = (uint8)rnd();
+
+    for (t = 0; t < sizeof(tests)/sizeof(tests[0]); t++) {
+        struct test *tp = &tests[t];
+
+        if (tp->pack) {
+            tp->old(words, bout[0], NSECT * WPS);
+            tp->new(words, bout[1], NSECT * WPS);
+            i = memcmp(bout[0], bout[1], sizeof(bout[0]));
+        } else {
+            tp->old(wout[0], bytes, NSECT * WPS);
+            tp->new(wout[1], bytes, NSECT * WPS);
+            i = memcmp(wout[0], wout[1], sizeof(wout[0]));
+        }
+        if (i != 0) {
+            printf("%s: differs from the old code\n", tp->name);
+            return 1;
+        }
+    }
+
+    printf("%d word sectors, %ld passes of %d sectors\n", WPS, passes, NSECT);
+    for (t = 0; t < sizeof(tests)/sizeof(tests[0]); t++) {
+        struct test *tp = &tests[t];
+        double o = run(tp->old, tp->pack, passes);
+        double n = run(tp->new, tp->pack, passes);
+
+        printf("%-12s %7.1fns -> %7.1fns per sector\n", tp->name, o, n);
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * IP checksum check for kx10_imp.c:
+ * cc -O2 -o impcksum impcksum.c
+ *
+ * ./impcksum                  exit status 1 on any difference
+ *
+ * Checks ip_checksum against the byte at a time sum of RFC 1071 for
+ * every length up to a full packet at every alignment, and checks that
+ * checksumadjust gives the same checksum as summing the changed packet
+ * again, both for replaced data and for added data (the pseudo header).
+ *
+ * ip_sum, ip_sum_fold, ip_checksum and checksumadjust are copies of
+ * the ones in kx10_imp.c; keep them the same.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+typedef unsigned long long t_uint64;
+typedef unsigned int uint32;
+typedef unsigned short uint16;
+typedef unsigned char uint8;
+
+/* The checksum code in kx10_imp.c */
+
+static t_uint64
+ip_sum(t_uint64 sum, const uint8 *ptr, int len)
+{
+    uint32   w[4];
+    uint16   h;
+
+    while (len >= 16) {
+        memcpy(w, ptr, 16);
+        sum += (t_uint64)w[0] + w[1] + w[2] + w[3];
+        ptr += 16;
+        len -= 16;
+    }
+    while (len >= 4) {
+        memcpy(w, ptr, 4);
+        sum += w[0];
+        ptr += 4;
+        len -= 4;
+    }
+    if (len >= 2) {
+        memcpy(&h, ptr, 2);
+        sum += h;
+        ptr += 2;
+        len -= 2;
+    }
+    /* Add left-over byte, if any, as the first byte of a word */
+    if (len > 0) {
+        h = 0;
+        memcpy(&h, ptr, 1);
+        sum += h;
+    }
+    return sum;
+}
+
+static uint16
+ip_sum_fold(t_uint64 sum)
+{
+    while (sum >> 16)
+        sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16)sum;
+}
+
+static void
+ip_checksum(uint8 *chksum, uint8 *ptr, int len)
+{
+    uint16   sum = ~ip_sum_fold(ip_sum(0, ptr, len));
+
+    memcpy(chksum, &sum, 2);
+}
+
+static void
+checksumadjust(uint8 *chksum, uint8 *optr,
+   int olen, uint8 *nptr, int nlen)
+{
+    uint16   hc;
+    t_uint64 sum;
+
+    memcpy(&hc, chksum, 2);
+    sum = (uint16)~hc;
+    sum += (uint16)~ip_sum_fold(ip_sum(0, optr, olen));
+    sum = ip_sum(sum, nptr, nlen);
+    hc = ~ip_sum_fold(sum);
+    memcpy(chksum, &hc, 2);
+}
+
+/* RFC 1071, one big endian 16 bit word at a time */
+static void
+ref_checksum(uint8 *chksum, const uint8 *ptr, int len)
+{
+    uint32   sum = 0;
+    int      i;
+
+    for (i = 0; i + 1 < len; i += 2)
+        sum += (ptr[i] << 8) | ptr[i + 1];
+    if (i < len)
+        sum += ptr[i] << 8;
+    while (sum >> 16)
+        sum = (sum & 0xffff) + (sum >> 16);
+    sum = ~sum & 0xffff;
+    chksum[0] = (uint8)(sum >> 8);
+    chksum[1] = (uint8)sum;
+}
+
+static uint32 seed = 1;
+
+static uint8
+rnd(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (uint8)(seed >> 16);
+}
+
+#define MAXLEN  1500
+
+static int
+fail(const char *what, int len, int off, const uint8 *want, const uint8 *got)
+{
+    printf("%s: length %d offset %d: want %02x%02x got %02x%02x\n",
+           what, len, off, want[0], want[1], got[0], got[1]);
+    return 1;
+}
+
+int
+main(void)
+{
+    /* RFC 1071 section 3 example: sum 0xddf2, checksum 0x220d */
+    static uint8 rfc[] = { 0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7 };
+    static uint8 rfc_ck[] = { 0x22, 0x0d };
+    uint8 buf[MAXLEN + 4 + 40], pkt[MAXLEN + 40];
+    uint8 want[2], got[2];
+    int len, off, pos, n, i;
+
+    ip_checksum(got, rfc, sizeof(rfc));
+    if (memcmp(got, rfc_ck, 2) != 0)
+        return fail("RFC 1071 example", sizeof(rfc), 0, rfc_ck, got);
+
+    /* Every length at every alignment */
+    for (len = 0; len <= MAXLEN; len++) {
+        for (off = 0; off < 4; off++) {
+            for (i = 0; i < len; i++)
+                buf[off + i] = rnd();
+            ref_checksum(want, buf + off, len);
+            ip_checksum(got, buf + off, len);
+            if (memcmp(want, got, 2) != 0)
+                return fail("ip_checksum", len, off, want, got);
+        }
+    }
+
+    /* Replace n bytes at an even position, as the address rewrites do.
+       The checksum is in the first word. */
+    for (i = 0; i < 20000; i++) {
+        len = 20 + (rnd() | (rnd() << 8)) % (MAXLEN - 20);
+        n = 2 * (1 + rnd() % 6);
+        pos = 2 + 2 * ((rnd() | (rnd() << 8)) % ((len - 2 - n) / 2 + 1));
+        for (off = 0; off < len; off++)
+            pkt[off] = rnd();
+        pkt[0] = pkt[1] = 0;
+        ref_checksum(pkt, pkt, len);
+        memcpy(buf, &pkt[pos], n);
+        for (off = 0; off < n; off++)
+            pkt[pos + off] = rnd();
+        memcpy(got, pkt, 2);
+        checksumadjust(got, buf, n, &pkt[pos], n);
+        memcpy(pkt, got, 2);
+        ref_checksum(want, pkt, len);           /* 0 if the sum is right */
+        if (want[0] != 0 || want[1] != 0)
+            return fail("checksumadjust replace", len, pos, want, got);
+    }
+
+    /* Add a pseudo header to the sum of an even length packet */
+    for (i = 0; i < 20000; i++) {
+        len = 2 * (4 + (rnd() | (rnd() << 8)) % (MAXLEN / 2 - 4));
+        n = (i & 1) ? 12 : 2 * (1 + rnd() % 20);
+        for (off = 0; off < len + n; off++)
+            pkt[off] = rnd();
+        ref_checksum(got, pkt, len);
+        checksumadjust(got, NULL, 0, &pkt[len], n);
+        ref_checksum(want, pkt, len + n);
+        if (memcmp(want, got, 2) != 0)
+            return fail("checksumadjust add", len, n, want, got);
+    }
+
+    printf("ok\n");
+    return 0;
+}
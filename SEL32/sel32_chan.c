@@ -904,6 +904,107 @@ int chan_write_byte(uint16 chsa, uint8 *data)
     return 0;
 }
 
+/* write a block of bytes to memory */
+/* read from device */
+/* return the number of bytes transferred, less than len on error or end */
+/* data.  Runs inside the current IOCD are packed directly into M[], the */
+/* IOCD boundaries, skip and read backward cases go through chan_write_byte */
+int chan_write_block(uint16 chsa, uint8 *data, int len)
+{
+    CHANP   *chp = find_chanp_ptr(chsa);        /* get channel prog pointer */
+    int     cnt = 0;                            /* bytes transferred */
+
+    while (cnt < len) {
+        uint32  addr = chp->ccw_addr & MASK24;  /* memory buffer address */
+        uint32  n = len - cnt;                  /* bytes left to write */
+        uint8   *dp;                            /* data for this run */
+
+        /* let the byte code handle anything but a plain forward transfer */
+        if ((chp->ccw_count == 0) || (chp->chan_status & STATUS_ERROR) ||
+            (chp->chan_byte == BUFF_CHNEND) || (chp->ccw_flags & FLAG_SKIP) ||
+            ((chp->ccw_cmd & 0xff) == CMD_RDBWD) || !MEM_ADDR_OK(addr)) {
+            if (chan_write_byte(chsa, &data[cnt]))
+                break;                          /* error or end of data */
+            cnt++;                              /* one more byte done */
+            continue;
+        }
+        if (n > chp->ccw_count)
+            n = chp->ccw_count;                 /* stop at end of this IOCD */
+        if (n > (uint32)MEMSIZE - addr)
+            n = (uint32)MEMSIZE - addr;         /* byte code will set PCHK */
+        sim_debug(DEBUG_DATA, &cpu_dev,
+            "chan_write_block WRITE addr %06x count %04x\n", addr, n);
+        chp->ccw_addr += n;                     /* next byte address */
+        chp->ccw_count -= n;                    /* reduce count */
+        chp->chan_byte = BUFF_BUSY;             /* busy, but no data */
+        dp = &data[cnt];                        /* start of this run */
+        cnt += n;
+        /* bytes up to a word boundary */
+        for (; n && (addr & 3); n--, addr++)
+            WMB(addr, *dp++);
+        /* whole words, first byte is the most significant one */
+        for (; n >= 4; n -= 4, addr += 4, dp += 4)
+            M[addr>>2] = ((uint32)dp[0] << 24) | ((uint32)dp[1] << 16) |
+                ((uint32)dp[2] << 8) | dp[3];
+        /* trailing bytes */
+        for (; n; n--, addr++)
+            WMB(addr, *dp++);
+    }
+    return cnt;
+}
+
+/* read a block of bytes from memory */
+/* write to device */
+/* return the number of bytes transferred, less than len on error or end */
+/* data.  Runs inside the current IOCD are unpacked directly from M[], the */
+/* IOCD boundaries are handled by chan_read_byte */
+int chan_read_block(uint16 chsa, uint8 *data, int len)
+{
+    CHANP   *chp = find_chanp_ptr(chsa);        /* get channel prog pointer */
+    int     cnt = 0;                            /* bytes transferred */
+
+    while (cnt < len) {
+        uint32  addr = chp->ccw_addr & MASK24;  /* memory buffer address */
+        uint32  n = len - cnt;                  /* bytes left to read */
+        uint8   *dp;                            /* data for this run */
+
+        /* let the byte code handle data chaining, errors and end of data */
+        if ((chp->ccw_count == 0) || (chp->chan_status & STATUS_ERROR) ||
+            (chp->chan_byte == BUFF_CHNEND) || !MEM_ADDR_OK(addr)) {
+            if (chan_read_byte(chsa, &data[cnt]))
+                break;                          /* error or end of data */
+            cnt++;                              /* one more byte done */
+            continue;
+        }
+        if (n > chp->ccw_count)
+            n = chp->ccw_count;                 /* stop at end of this IOCD */
+        if (n > (uint32)MEMSIZE - addr)
+            n = (uint32)MEMSIZE - addr;         /* byte code will set PCHK */
+        sim_debug(DEBUG_DATA, &cpu_dev,
+            "chan_read_block READ addr %06x count %04x\n", addr, n);
+        chp->ccw_addr += n;                     /* next byte address */
+        chp->ccw_count -= n;                    /* n chars less to process */
+        dp = &data[cnt];                        /* start of this run */
+        cnt += n;
+        /* bytes up to a word boundary */
+        for (; n && (addr & 3); n--, addr++)
+            *dp++ = RMB(addr);
+        /* whole words, first byte is the most significant one */
+        for (; n >= 4; n -= 4, addr += 4, dp += 4) {
+            uint32  word = M[addr>>2];
+
+            dp[0] = (word >> 24) & 0xff;
+            dp[1] = (word >> 16) & 0xff;
+            dp[2] = (word >> 8) & 0xff;
+            dp[3] = word & 0xff;
+        }
+        /* trailing bytes */
+        for (; n; n--, addr++)
+            *dp++ = RMB(addr);
+    }
+    return cnt;
+}
+
 /* post wakeup interrupt for specified async line */
 void set_devwake(uint16 chsa, uint16 flags)
 {
@@ -71,6 +71,17 @@ LOCAL   uint32  SPAD[256];                  /* Scratch pad memory */
 /* Concept 32/X7 has 2048 2KW maps per task */
 LOCAL   uint32  MAPC[1024];                 /* maps are 16bit entries on word bountries */
 LOCAL   uint32  TLB[2048];                  /* Translated addresses for each map entry */
+/* Translation cache for RealAddr, holds decoded real page address and */
+/* the 1/4 page protection for recently used 2KW maps */
+#define TLBC_SIZE       64                  /* # of entries, must be power of 2 */
+#define TLBC_VALID      0x10000             /* entry is valid */
+#define TLBC_PRIV       0x20000             /* entry loaded in privileged mode */
+#define TLBC_UMIDL      0x40000             /* 32/27 & 32/87 check user midl */
+LOCAL   struct tlbc {
+    uint32  tag;                            /* map index and flags, 0 if empty */
+    uint32  base;                           /* real page address */
+    uint8   prot[4];                        /* protection for each 1/4 page */
+} TLBC[TLBC_SIZE];
 LOCAL   uint32  PC;                         /* Program counter */
 LOCAL   uint32  IR;                         /* Last Instruction */
 LOCAL   uint32  HIWM=0;                     /* max maps loaded so far */
@@ -132,6 +143,9 @@ t_stat cpu_set_ipu(UNIT * uptr, int32 val, CONST char *cptr, void *desc);
 t_stat cpu_clr_ipu(UNIT * uptr, int32 val, CONST char *cptr, void *desc);
 t_stat cpu_show_ipu(FILE *st, UNIT *uptr, int32 val, CONST void *desc);
 #endif
+#ifndef CPUONLY
+t_stat cpu_ipc_test(UNIT * uptr, int32 val, CONST char *cptr, void *desc);
+#endif
 t_stat cpu_show_hist(FILE * st, UNIT * uptr, int32 val, CONST void *desc);
 t_stat cpu_set_hist(UNIT * uptr, int32 val, CONST char *cptr, void *desc);
 uint32 cpu_cmd(UNIT * uptr, uint16 cmd, uint16 dev);
@@ -311,6 +325,10 @@ MTAB cpu_mod[] = {
 #ifdef DEFINE_IPU_MODELS
     {MTAB_XTD|MTAB_VDV, 0, "IPU", "USEIPU", &cpu_set_ipu, &cpu_show_ipu},
     {MTAB_XTD|MTAB_VDV, 0, "NULL", "NOIPU", &cpu_clr_ipu, NULL},
+#endif
+#ifndef CPUONLY
+    {MTAB_XTD|MTAB_VDV, 0, NULL, "IPCTEST", &cpu_ipc_test, NULL, NULL,
+        "Check and time the CPU/IPU SIPU mailbox"},
 #endif
     {0}
 };
@@ -562,6 +580,256 @@ LOCAL void unlock_mutex()
     }
 }
 #endif
+
+/* SIPU mailbox between the CPU and IPU.  Each processor has one trap */
+/* slot in IPC->atrap that the peer fills and the owner empties with an */
+/* atomic exchange, so no lock is needed to pass a trap.  A processor */
+/* waiting for a trap, or for its peer to empty a full slot, sleeps on */
+/* its semaphore (fork) or the condition (thread) and is woken by the */
+/* peer instead of polling. */
+
+/* set ts to 10 ms from now */
+LOCAL void ipc_deadline(struct timespec *ts)
+{
+    clock_gettime(CLOCK_REALTIME, ts);
+    ts->tv_nsec += 10000000;                        /* 10 ms */
+    if (ts->tv_nsec >= 1000000000) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000;
+    }
+}
+
+/* post a trap to processor idx, return 0 if previous trap never taken */
+int ipc_post_trap(int idx, int trap)
+{
+    struct timespec ts;
+    int    r = 0;
+
+    /* only one trap may be pending, give the peer 10 ms to take it */
+    if (!__sync_bool_compare_and_swap(&IPC->atrap[idx], 0, trap)) {
+        ipc_deadline(&ts);
+#ifdef USE_POSIX_SEM
+        /* sleep on our own semaphore, the peer posts it when it takes */
+        /* the pending trap */
+        while (!__sync_bool_compare_and_swap(&IPC->atrap[idx], 0, trap)) {
+            if (r != 0 && errno == ETIMEDOUT) {
+                IPC->sleeping[idx ^ 1] = 0;
+                return 0;                           /* still full, drop it */
+            }
+            IPC->sleeping[idx ^ 1] = 1;             /* tell peer to wake us */
+            __sync_synchronize();
+            r = 0;
+            if (IPC->atrap[idx] != 0)
+                r = sem_timedwait((sem_t *)&(IPC->wakesem[idx ^ 1]), &ts);
+        }
+        IPC->sleeping[idx ^ 1] = 0;
+#else
+        pthread_mutex_lock((pthread_mutex_t *)&(IPC->mutex));
+        while (!__sync_bool_compare_and_swap(&IPC->atrap[idx], 0, trap)) {
+            if (r == ETIMEDOUT) {
+                pthread_mutex_unlock((pthread_mutex_t *)&(IPC->mutex));
+                return 0;                           /* still full, drop it */
+            }
+            r = pthread_cond_timedwait(&IPC->cond, &IPC->mutex, &ts);
+        }
+        pthread_mutex_unlock((pthread_mutex_t *)&(IPC->mutex));
+#endif
+    }
+#ifdef USE_POSIX_SEM
+    if (IPC->sleeping[idx])                         /* is peer waiting for trap */
+        sem_post((sem_t *)&(IPC->wakesem[idx]));    /* wake it up */
+#else
+    pthread_mutex_lock((pthread_mutex_t *)&(IPC->mutex));
+    pthread_cond_broadcast(&IPC->cond);             /* wake any waiters */
+    pthread_mutex_unlock((pthread_mutex_t *)&(IPC->mutex));
+#if defined(SIM_ASYNCH_IO)
+    /* the CPU may be idle in a WAIT instruction, wake it */
+    if ((idx == 0) && sim_idle_wait) {
+        pthread_mutex_lock(&sim_asynch_lock);
+        pthread_cond_signal(&sim_asynch_wake);
+        pthread_mutex_unlock(&sim_asynch_lock);
+    }
+#endif
+#endif
+    return 1;
+}
+
+/* take any pending trap for processor idx, 0 if none */
+int ipc_get_trap(int idx)
+{
+    int    trap = __sync_fetch_and_and(&IPC->atrap[idx], 0);
+
+    if (trap != 0) {
+        /* the peer may be waiting to post another one */
+#ifdef USE_POSIX_SEM
+        if (IPC->sleeping[idx ^ 1])
+            sem_post((sem_t *)&(IPC->wakesem[idx ^ 1]));
+#else
+        pthread_mutex_lock((pthread_mutex_t *)&(IPC->mutex));
+        pthread_cond_broadcast(&IPC->cond);
+        pthread_mutex_unlock((pthread_mutex_t *)&(IPC->mutex));
+#endif
+    }
+    return trap;
+}
+
+/* sleep until a trap is posted to processor idx */
+void ipc_wait_trap(int idx)
+{
+#ifdef USE_POSIX_SEM
+    struct timespec ts;
+
+    IPC->sleeping[idx] = 1;                         /* tell sender to wake us */
+    __sync_synchronize();
+    if (IPC->atrap[idx] == 0) {
+        /* time out so forked IPU still runs its event queue */
+        ipc_deadline(&ts);
+        sem_timedwait((sem_t *)&(IPC->wakesem[idx]), &ts);
+    }
+    IPC->sleeping[idx] = 0;
+#else
+    pthread_mutex_lock((pthread_mutex_t *)&(IPC->mutex));
+    while (IPC->atrap[idx] == 0)                    /* sleep on the condition */
+        pthread_cond_wait(&IPC->cond, &IPC->mutex); /* wait for wakeup */
+    pthread_mutex_unlock((pthread_mutex_t *)&(IPC->mutex));
+#endif
+}
+
+/* SET CPU IPCTEST, run the mailbox between two threads on a private */
+/* ipcom: time SIPU round trips, post to a full mailbox that the peer */
+/* empties later and to one it never empties.  A sender waiting on a */
+/* full mailbox must sleep, so it may use at most a quarter of the */
+/* wait in cpu time. */
+#define IPC_TEST_TRIPS  10000               /* round trips to time */
+
+/* test peer, echo traps posted to processor 1 back to 0 until -1 */
+LOCAL void *ipc_test_echo(void *arg)
+{
+    int    trap;
+
+    for (;;) {
+        ipc_wait_trap(1);
+        if ((trap = ipc_get_trap(1)) == 0)
+            continue;
+        if (trap == -1)
+            break;
+        ipc_post_trap(0, trap);
+    }
+    return NULL;
+}
+
+/* test peer, take the trap posted to processor 1 after 5 ms */
+LOCAL void *ipc_test_late(void *arg)
+{
+    sim_os_ms_sleep(5);
+    ipc_get_trap(1);
+    return NULL;
+}
+
+LOCAL t_stat ipc_test_trips(void)
+{
+    pthread_t   peer;
+    uint32      start, ms;
+    int         i, trap = 0;
+
+    if (pthread_create(&peer, NULL, ipc_test_echo, NULL) != 0)
+        return SCPE_IERR;
+    start = sim_os_msec();
+    for (i = 1; i <= IPC_TEST_TRIPS; i++) {
+        if (!ipc_post_trap(1, i))
+            break;
+        while ((trap = ipc_get_trap(0)) == 0)
+            ipc_wait_trap(0);
+        if (trap != i)
+            break;
+    }
+    ms = sim_os_msec() - start;
+    while (!ipc_post_trap(1, -1))                   /* stop the peer */
+        ;
+    pthread_join(peer, NULL);
+    if (i <= IPC_TEST_TRIPS)
+        return sim_messagef(SCPE_IERR, "SIPU round trip %d got trap %d\n", i, trap);
+    sim_printf("SIPU round trip %u.%03u us\n",
+        (ms * 1000) / IPC_TEST_TRIPS, ((ms * 1000000) / IPC_TEST_TRIPS) % 1000);
+    return SCPE_OK;
+}
+
+LOCAL t_stat ipc_test_full(void)
+{
+    pthread_t   peer;
+    uint32      start, ms;
+    clock_t     cpu;
+    int         r;
+
+    /* peer takes the pending trap after 5 ms, then ours goes in */
+    IPC->atrap[1] = 1;
+    if (pthread_create(&peer, NULL, ipc_test_late, NULL) != 0)
+        return SCPE_IERR;
+    start = sim_os_msec();
+    cpu = clock();
+    r = ipc_post_trap(1, 2);
+    pthread_join(peer, NULL);
+    if (!r || IPC->atrap[1] != 2)
+        return sim_messagef(SCPE_IERR, "SIPU not posted after mailbox emptied\n");
+
+    /* nobody takes the pending trap, ours is dropped after 10 ms */
+    IPC->atrap[1] = 1;
+    r = ipc_post_trap(1, 2);
+    cpu = clock() - cpu;
+    ms = sim_os_msec() - start;
+    if (r || IPC->atrap[1] != 1 || ms < 10)
+        return sim_messagef(SCPE_IERR, "SIPU to a full mailbox not dropped\n");
+    IPC->atrap[1] = 0;
+    if ((uint32)((cpu * 1000) / CLOCKS_PER_SEC) > ms / 4)
+        return sim_messagef(SCPE_IERR, "SIPU sender busy waited %u of %u ms\n",
+            (uint32)((cpu * 1000) / CLOCKS_PER_SEC), ms);
+    sim_printf("SIPU full mailbox waits %u ms, cpu %u ms\n",
+        ms, (uint32)((cpu * 1000) / CLOCKS_PER_SEC));
+    return SCPE_OK;
+}
+
+LOCAL t_stat ipc_test_run(void)
+{
+    SIM_TEST_INIT;
+    SIM_TEST(ipc_test_trips());
+    SIM_TEST(ipc_test_full());
+    return SCPE_OK;
+}
+
+t_stat cpu_ipc_test(UNIT *uptr, int32 val, CONST char *cptr, void *desc)
+{
+    struct ipcom    tipc;
+    struct ipcom    *saved = IPC;
+    t_stat          r;
+
+    if (cptr != NULL)
+        return SCPE_ARG;
+#ifdef USE_IPU_THREAD
+    if (got_ipu)
+#else
+    if (IPC != 0 && IPC->pid[1] != 0)
+#endif
+        return sim_messagef(SCPE_NOFNC, "IPU is running\n");
+    memset(&tipc, 0, sizeof(tipc));
+#ifdef USE_POSIX_SEM
+    sem_init((sem_t *)&(tipc.wakesem[0]), 1, 0);
+    sem_init((sem_t *)&(tipc.wakesem[1]), 1, 0);
+#else
+    pthread_mutex_init(&tipc.mutex, NULL);
+    pthread_cond_init(&tipc.cond, NULL);
+#endif
+    IPC = &tipc;
+    r = ipc_test_run();
+    IPC = saved;
+#ifdef USE_POSIX_SEM
+    sem_destroy((sem_t *)&(tipc.wakesem[0]));
+    sem_destroy((sem_t *)&(tipc.wakesem[1]));
+#else
+    pthread_mutex_destroy(&tipc.mutex);
+    pthread_cond_destroy(&tipc.cond);
+#endif
+    return r;
+}
 #endif /* CPUONLY */
 
 #ifdef NOT_USED
@@ -590,6 +858,48 @@ LOCAL uint32 set_modes(uint32 psd[2])
 }
 #endif
 
+/* invalidate every entry in the translation cache */
+LOCAL void tlbc_flush_all(void)
+{
+    memset(TLBC, 0, sizeof(TLBC));                  /* clear all tags */
+}
+
+/* invalidate the translation cache entry for map number page */
+LOCAL void tlbc_flush(uint32 page)
+{
+    struct tlbc *tc = &TLBC[page & (TLBC_SIZE-1)];
+
+    if ((tc->tag & 0x7ff) == page)
+        tc->tag = 0;                                /* entry no longer valid */
+}
+
+/* enter a good translation for map index into the translation cache */
+/* raddr is the TLB entry for the map and map the MAPC entry */
+LOCAL void tlbc_load(uint32 index, uint32 raddr, uint32 map, uint32 flags)
+{
+    struct tlbc *tc = &TLBC[index & (TLBC_SIZE-1)];
+    uint32 i;
+
+    tc->tag = index | flags | TLBC_VALID;
+    if (MODES & PRIVBIT)
+        tc->tag |= TLBC_PRIV;                       /* only good in privileged mode */
+    tc->base = raddr & 0xffe000;                    /* real page address */
+    for (i = 0; i < 4; i++) {
+        if (CPU_MODEL < MODEL_V6) {
+            /* 27, 87, 67 & 97 have write protect bit for each 1/4 page */
+            if (((MODES & PRIVBIT) == 0) && ((BIT1 >> i) & raddr))
+                tc->prot[i] = 1;                    /* 1/4 page is write protected */
+            else
+                tc->prot[i] = 0;
+        } else {
+            /* V6 & V9 get access bits p1 & p2 from map */
+            tc->prot[i] = (map >> 12) & 0x6;
+            if (MODES & PRIVBIT)
+                tc->prot[i] |= 0x8;                 /* set priv bit */
+        }
+    }
+}
+
 /* set up the map registers for the current task in the cpu */
 /* the PSD bpix and cpix are used to setup the maps */
 /* return non-zero if mapping error */
@@ -610,6 +920,8 @@ LOCAL t_stat load_maps(uint32 thepsd[2], uint32 lmap)
         "Load Maps Entry PSD %08x %08x STATUS %08x lmap %1x CPU Mode %2x\n",
         thepsd[0], thepsd[1], CPUSTATUS, lmap, CPU_MODEL);
 
+    tlbc_flush_all();                               /* maps are changing, flush cache */
+
     /* process 32/7X computers */
     if (CPU_MODEL < MODEL_27) {
         MAXMAP = MAX32;                             /* 32 maps for 32/77 */
@@ -1132,6 +1444,7 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
     uint32  word, index, map, raddr, mpl, offset;
     uint32  nix, msdl, mix;
     uint32  MAXMAP = MAX2048;                       /* default to 2048 maps */
+    struct tlbc *tc;
 
     *prot = 0;      /* show unprotected memory as default */
                     /* unmapped mode is unprotected */
@@ -1205,6 +1518,21 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
 
     mpl = SPAD[0xf3] & MASK24;                      /* get 24 bit dbl wd mpl from spad address */
 
+    /* get 11 bit page number from address bits 8-18 */
+    index = (word >> 13) & 0x7ff;                   /* get 11 bit page value */
+    offset = word & 0x1fff;                         /* get 13 bit page offset */
+
+    /* see if translation is in the cache, if so skip the map decode */
+    tc = &TLBC[index & (TLBC_SIZE-1)];
+    if (((tc->tag & ~TLBC_UMIDL) == (index | TLBC_VALID |
+        ((MODES & PRIVBIT) ? TLBC_PRIV : 0))) &&
+        MEM_ADDR_OK(RMW(mpl+4) & MASK24) &&         /* O/S midl still good */
+        (((tc->tag & TLBC_UMIDL) == 0) || MEM_ADDR_OK(RMW(mpl+CPIX+4) & MASK24))) {
+        *realaddr = tc->base | offset;              /* return the real address */
+        *prot = tc->prot[offset >> 11];             /* protection for 1/4 page */
+        return ALLOK;                               /* all OK, return instruction */
+    }
+
     /* set maximum maps for 32/27 and 32/87 processors */
     if ((CPU_MODEL == MODEL_27) || (CPU_MODEL == MODEL_87))
         MAXMAP = MAX256;                            /* only 256 2KW (8kb) maps */
@@ -1238,10 +1566,6 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
     }
 
     /* we are mapped, so calculate real address from map information */
-    /* get 11 bit page number from address bits 8-18 */
-    index = (word >> 13) & 0x7ff;                   /* get 11 bit page value */
-    offset = word & 0x1fff;                         /* get 13 bit page offset */
-
     if (MODES & MAPMODE) {
         uint32 mpl = SPAD[0xf3];                    /* get mpl from spad address */
         uint32 cpix = CPIX;                         /* get cpix 11 bit offset from psd wd 2 */
@@ -1306,6 +1630,7 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
         }
         word = (raddr & 0xffe000) | offset;         /* combine real addr and offset */
         *realaddr = word;                           /* return the real address */
+        tlbc_load(index, raddr, map, TLBC_UMIDL);   /* save the translation */
         if (MODES & PRIVBIT)                        /* all OK if privledged */
             return ALLOK;                           /* all OK, return instruction */
 
@@ -1347,6 +1672,7 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
         map = RMR((index<<1));                      /* read the map reg contents */
         word = (raddr & 0xffe000) | offset;         /* combine map and offset */
         *realaddr = word;                           /* return the real address */
+        tlbc_load(index, raddr, map, 0);            /* save the translation */
 
         /* handle 32/67 & 32/97 protection here */
         if (CPU_MODEL < MODEL_V6) {
@@ -1473,6 +1799,7 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
     TLB[nix] = ((map & 0x7ff) << 13) | ((map << 16) & 0xf8000000) | 0x04000000;
     word = (TLB[nix] & 0xffe000) | offset;          /* combine map and offset */
     WMR((nix<<1), map);                             /* store the map reg contents into MAPC cache */
+    tlbc_flush(nix);                                /* drop any old translation */
     sim_debug(DEBUG_DETAIL, my_dev,
         "RealAddrm RMH %04x mix %04x TLB[%04x] %08x B+C %04x RMR[nix] %04x\n",
         map, mix, nix, TLB[nix], BPIX+CPIXPL, RMR(nix<<1));
@@ -1545,6 +1872,7 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
                     TLB[nix] = ((map & 0x7ff) << 13) | ((map << 16) & 0xf8000000) | 0x04000000;
                     word = (TLB[nix] & 0xffe000);   /* combine map and offset */
                     WMR((nix<<1), map);             /* store the map reg contents into MAPC cache */
+                    tlbc_flush(nix);                /* drop any old translation */
                     sim_debug(DEBUG_DETAIL, my_dev,
                         "Addr2b %06x RealAddr %06x Map2[%04x] HIT %04x, TLB[%3x] %08x MAPC[%03x] %08x\n",
                         addr, word, mix, map, nix, TLB[nix], nix/2, MAPC[nix/2]);
@@ -1640,6 +1968,7 @@ LOCAL t_stat Mem_read(uint32 addr, uint32 *data)
                 if (((map & 0x800) == 0)) {
                     map |= 0x800;                   /* set the accessed bit in the map cache entry */
                     WMR((page<<1), map);            /* store the map reg contents into cache */
+                    tlbc_flush(page);               /* drop any old translation */
                     TLB[page] |= 0x0c000000;        /* set the accessed bit in TLB too */
                     WMH(msdl+(mix<<1), map);        /* save modified map with access bit set */
                     sim_debug(DEBUG_DETAIL, my_dev,
@@ -1729,6 +2058,7 @@ LOCAL t_stat Mem_write(uint32 addr, uint32 *data)
                 if ((nmap & 0x1000) == 0) {
                     nmap |= 0x1800;                 /* set the modify/accessed bit in the map cache entry */
                     WMR((page<<1), nmap);           /* store the map reg contents into cache */
+                    tlbc_flush(page);               /* drop any old translation */
                     TLB[page] |= 0x18000000;        /* set the modify/accessed bits in TLB too */
                     WMH((msdl+(mix << 1)), nmap);   /* save modified map with access bit set */
                     sim_debug(DEBUG_DETAIL, my_dev,
@@ -1848,6 +2178,7 @@ t_stat sim_instr(void) {
     int32               int32c;                     /* temp int */
 
     reason = SCPE_OK;
+    tlbc_flush_all();                               /* maps may have been changed by user */
 
     /* loop here until time out or error found */
 wait_loop:
@@ -1950,6 +2281,10 @@ wait_loop:
                     if (errno == ENOSYS)
                         fprintf(stderr,"POSIX semaphores not valid for this processsor\r\n");
                 }
+                /* SIPU wakeup for each processor */
+                sem_init((sem_t *)&(IPC->wakesem[0]), 1, 0);
+                sem_init((sem_t *)&(IPC->wakesem[1]), 1, 0);
+                IPC->sleeping[0] = IPC->sleeping[1] = 0;
 #else
 #ifdef USE_POSIX_SEM
                 /* shared by threads */
@@ -2033,8 +2368,7 @@ wait_loop:
                     sim_debug(DEBUG_TRAP, my_dev,
                         "Starting IPU WAIT in fork\n");
 #ifdef USE_POSIX_SEM
-                    sim_os_ms_sleep(10);            /* wait 10 ms */
-//                  millinap(1);                    /* wait 1 ms */
+                    ipc_wait_trap(MyIndex);         /* wait for 1st sipu */
 #endif
                     goto wait_loop;                 /* continue waiting */
                 }
@@ -2085,8 +2419,7 @@ loadend:
             /* interrupts must be unblocked to take the sipu trap */
             if (((CPUSTATUS & ONIPU) == 0) && IPC && ((CPUSTATUS & BIT24) == 0) &&
                 IPC->atrap[MyIndex]) {
-                TRAPME = IPC->atrap[MyIndex];
-                IPC->atrap[MyIndex] = 0;
+                TRAPME = ipc_get_trap(MyIndex);     /* get and clear trap */
                 IPC->received[MyIndex]++;
                 sim_debug(DEBUG_TRAP, my_dev, "%s: (%d) Async TRAP %02x Index %x PeerIndex %x\n",
                     (CPUSTATUS & ONIPU) ? "IPU" : "CPU", __LINE__, TRAPME, MyIndex, PeerIndex);
@@ -2103,8 +2436,7 @@ loadend:
             if ((CPUSTATUS & ONIPU) && ((CPUSTATUS & BIT24) == 0)) {
                 if (IPC && IPC->atrap[MyIndex]) {
                     wait4sipu = 0;                  /* wait is over for sipu */
-                    TRAPME = IPC->atrap[MyIndex];   /* get trap number */
-                    IPC->atrap[MyIndex] = 0;        /* clear flag */
+                    TRAPME = ipc_get_trap(MyIndex); /* get and clear trap */
                     IPC->received[MyIndex]++;
                     sim_debug(DEBUG_TRAP, my_dev, "%s: (%d) Async TRAP %02x SPAD[0xf0] %08x\n",
                         (CPUSTATUS & ONIPU) ? "IPU" : "CPU", __LINE__, TRAPME, SPAD[0xf0]);
@@ -2116,8 +2448,7 @@ loadend:
                     goto newpsd;                    /* go process trap */
                 }
                 if (wait4sipu) {
-                    sim_os_ms_sleep(10);            /* wait 10 ms */
-//                  millinap(1);                    /* wait 1 ms */
+                    ipc_wait_trap(MyIndex);         /* sleep until sipu */
                     goto wait_loop;                 /* continue waiting */
                 }
             }
@@ -2126,8 +2457,7 @@ loadend:
             /* interrupts must be unblocked to take the sipu trap */
             if (((CPUSTATUS & ONIPU) == 0) && IPC && ((CPUSTATUS & BIT24) == 0) &&
                 IPC->atrap[MyIndex]) {
-                TRAPME = IPC->atrap[MyIndex];
-                IPC->atrap[MyIndex] = 0;
+                TRAPME = ipc_get_trap(MyIndex);     /* get and clear trap */
                 IPC->received[MyIndex]++;
                 sim_debug(DEBUG_TRAP, my_dev,
                     "%s: (%d) Async TRAP %02x Index %x PeerIndex %x rec'd %08x\n",
@@ -2150,10 +2480,7 @@ loadend:
                 /* we have a trap available, lock and get it */
 cond_go:
                 if (IPC && IPC->atrap[MyIndex]) {
-                    lock_mutex();                   /* lock mutex */
-                    TRAPME = IPC->atrap[MyIndex];   /* get trap number */
-                    IPC->atrap[MyIndex] = 0;        /* clear trap value location */
-                    unlock_mutex();                 /* unlock mutex */
+                    TRAPME = ipc_get_trap(MyIndex); /* get and clear trap */
                     IPC->received[MyIndex]++;       /* count it received */
                     wait4sipu = 0;                  /* wait is over for sipu */
                     sim_debug(DEBUG_TRAP, my_dev, "%s: (%d) Async TRAP %02x SPAD[0xf0] %02x rec'd %08x\n",
@@ -2167,10 +2494,7 @@ cond_go:
                 }
                 /* unblocked and locked and no async trap */
                 if (wait4sipu) {                    /* are we to wait */
-                    lock_mutex();                   /* lock mutex */
-                    while (IPC->atrap[MyIndex]==0)  /* sleep on the condition */
-                        pthread_cond_wait(&IPC->cond, &IPC->mutex); /* wait for wakeup */
-                    unlock_mutex();                 /* unlock mutex and continue */
+                    ipc_wait_trap(MyIndex);         /* sleep until sipu */
                     goto cond_go;                   /* go process */
                 }
                 /* not waiting for sipu, so continue processing */
@@ -2806,7 +3130,7 @@ exec2:
                     }
                     else {
 #ifdef USE_POSIX_SEM
-                        sim_os_ms_sleep(10);        /* wait 10 ms */
+                        ipc_wait_trap(MyIndex);     /* sleep until sipu */
                         goto wait_loop;             /* continue waiting */
 #else
                         wait4sipu = 1;              /* show we are waiting for SIPU */
@@ -2897,7 +3221,7 @@ exec2:
                     }
                     else {
 #ifdef USE_POSIX_SEM
-                        sim_os_ms_sleep(10);        /* wait 10 ms */
+                        ipc_wait_trap(MyIndex);     /* sleep until sipu */
                         goto wait_loop;             /* continue waiting */
 #else
                         wait4sipu = 1;              /* show we are waiting for SIPU */
@@ -3036,54 +3360,25 @@ exec2:
 #ifndef CPUONLY
                 if (CCW & HASIPU) {
                     /* CPU side = [0] IPU side = [1] */
-                    //GR if (IPC && IPC->atrap[PeerIndex]) {
-#ifdef USE_POSIX_SEM
-                    if (IPC->atrap[PeerIndex]) {
-                        /* previous atrap not yet handled */
-                        IPC->blocked[MyIndex]++;
-                        sim_debug(DEBUG_TRAP, my_dev,
-                            "%s: Async SIPU blocked CPUSTATUS %08x CCW %08x\n",
-                            (CPUSTATUS & ONIPU)? "IPU": "CPU", CPUSTATUS, CCW);
-
-                        //GR  Give it a millisec to unblock the atrap
-                        sim_os_ms_sleep(10);        /* wait 10 ms */
-                    }
-
-                    if (IPC->atrap[PeerIndex] == 0) {
-                        IPC->sent[MyIndex]++;
-                        IPC->atrap[PeerIndex] = SIGNALIPU_TRAP;
-                        sim_debug(DEBUG_TRAP, my_dev,
-                            "%s: Async SIPU sent CPUSTATUS %08x CCW %02x\n",
-                            (CPUSTATUS & ONIPU)? "IPU": "CPU", CPUSTATUS, CCW);
-                    }
-                    else
-                        IPC->dropped[MyIndex]++;
-#else
                     if (IPC->atrap[PeerIndex]) {
                         /* previous atrap not yet handled if not zero */
                         IPC->blocked[MyIndex]++;    /* count as blocked */
                         sim_debug(DEBUG_TRAP, my_dev,
-                            "%s: Async SIPU blocked IPUSTATUS %08x CCW %08x SPAD[0xf0] %02x block %08x\n",
+                            "%s: Async SIPU blocked CPUSTATUS %08x CCW %08x SPAD[0xf0] %02x block %08x\n",
                             (CPUSTATUS & ONIPU)? "IPU": "CPU", CPUSTATUS, CCW, SPAD[0xf0], IPC->blocked[MyIndex]);
-                        //GR  Give it a millisec to unblock the atrap
-                        sim_os_ms_sleep(10);        /* wait 10 ms */
                     }
-                    if (IPC->atrap[PeerIndex] == 0) {
-                        lock_mutex();               /* lock mutex */
-                        IPC->atrap[PeerIndex] = SIGNALIPU_TRAP;
-                        pthread_cond_signal(&IPC->cond);    /* wake any waiters */
-                        unlock_mutex();             /* unlock mutex */
+                    /* post the trap, waits up to 10 ms for a full mailbox */
+                    if (ipc_post_trap(PeerIndex, SIGNALIPU_TRAP)) {
                         IPC->sent[MyIndex]++;
                         sim_debug(DEBUG_TRAP, my_dev,
-                            "%s: Async SIPU sent IPUSTATUS %08x CCW %08x SPAD[0xf0] %02x sent %08x\n",
+                            "%s: Async SIPU sent CPUSTATUS %08x CCW %08x SPAD[0xf0] %02x sent %08x\n",
                             (CPUSTATUS & ONIPU)? "IPU": "CPU", CPUSTATUS, CCW, SPAD[0xf0], IPC->sent[MyIndex]);
                     } else {
                         IPC->dropped[MyIndex]++;    /* count dropped SIPU */
                         sim_debug(DEBUG_TRAP, my_dev,
-                            "%s: Async SIPU sent IPUSTATUS %08x CCW %08x SPAD[0xf0] %02x drop %08x\n",
+                            "%s: Async SIPU sent CPUSTATUS %08x CCW %08x SPAD[0xf0] %02x drop %08x\n",
                             (CPUSTATUS & ONIPU)? "IPU": "CPU", CPUSTATUS, CCW, SPAD[0xf0], IPC->dropped[MyIndex]);
                     }
-#endif /* USE_POSIX_SEM */
                 } else
 #endif
                 {
@@ -5091,6 +5386,7 @@ doovr3:
                     Mmap |= 0x800;                  /* set the accessed bit in the map cache entry */
                     map |= 0x800;                   /* set the accessed bit in the memory map entry */
                     WMR((nix<<1), map);             /* store the map reg contents into cache */
+                    tlbc_flush(nix);                /* drop any old translation */
                     TLB[nix] |= 0x0c000000;         /* set the accessed & hit bits in TLB too */
                     WMH(msdl+(mix<<1), Mmap);       /* save modified memory map with access bit set */
                     sim_debug(DEBUG_EXP, my_dev,
@@ -7864,6 +8160,7 @@ t_stat cpu_reset(DEVICE *dptr)
             ival = 0xfffffff;                       /* init value for 32/7x int and dev entries */
         for (i = 0; i < 1024; i++)
             MAPC[i] = 0;                            /* clear 2048 halfword map cache */
+        tlbc_flush_all();                           /* clear the translation cache */
         for (i = 0; i < 224; i++)
             SPAD[i] = ival;                         /* init 128 devices and 96 ints in the spad */
         for (i = 224; i < 256; i++)                 /* clear the last 32 extries */
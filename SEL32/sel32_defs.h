@@ -95,6 +95,8 @@ struct ipcom {
     sem_t   simsem;                     /* the semaphore */
     int     pass[2];                    /* count passing */
     int     wait[2];                    /* count waiting */
+    sem_t   wakesem[2];                 /* wakeup for SIPU waiter */
+    int     sleeping[2];                /* set when waiting for SIPU */
 };
 #else
 /* Use pthread mutexs */
@@ -583,6 +585,8 @@ extern  t_stat  show_dev_addr(FILE * st, UNIT *uptr, int32 v, CONST void *desc);
 extern  void    chan_end(uint16 chan, uint16 flags);
 extern  int     chan_read_byte(uint16 chsa, uint8 *data);
 extern  int     chan_write_byte(uint16 chsa, uint8 *data);
+extern  int     chan_read_block(uint16 chsa, uint8 *data, int len);
+extern  int     chan_write_block(uint16 chsa, uint8 *data, int len);
 extern  void    set_devattn(uint16 addr, uint16 flags);
 extern  void    set_devwake(uint16 chsa, uint16 flags);
 extern  t_stat  chan_boot(uint16 addr, DEVICE *dptr);
@@ -599,6 +603,9 @@ extern  uint32  *M;                     /* our memory shared with fork IPU */
 extern  struct ipcom *IPC;
 extern  uint32  M[];                    /* our local memory with thread IPU */
 #endif
+extern  int     ipc_post_trap(int idx, int trap);   /* send SIPU trap to peer */
+extern  int     ipc_get_trap(int idx);  /* take pending SIPU trap */
+extern  void    ipc_wait_trap(int idx); /* sleep until SIPU trap */
 #else
 extern  uint32  M[];                    /* our local memory without IPU */
 #endif
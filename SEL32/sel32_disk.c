@@ -1942,22 +1942,20 @@ if ((chp->ccw_addr == 0x3cde0) && (buf[0] == 0x4a)) {
 #endif
             uptr->CHS++;                        /* next sector number */
             /* process the next sector of data */
-            for (i=0; i<len; i++) {
-                ch = buf[i];                    /* get a char from buffer */
-                if (chan_write_byte(chsa, &ch)) {   /* put a byte to memory */
-                    if (chp->chan_status & STATUS_PCHK) /* test for memory error */
-                        uptr->SNS |= SNS_INAD;  /* invalid address */
-                    sim_debug(DEBUG_EXP, dptr,
-                        "DISK READ4 %04x bytes leaving %04x from diskfile %04x/%02x/%02x\n",
-                        i, chp->ccw_count, ((uptr->CHS)>>16)&0xffff,
-                        ((uptr->CHS)>>8)&0xff, (uptr->CHS)&0xff);
-                    uptr->CMD &= LMASK;         /* remove old status bits & cmd */
-                    if (chp->chan_status & STATUS_PCHK) /* test for memory error */
-                        chan_end(chsa, SNS_CHNEND|SNS_DEVEND|STATUS_PCHK);
-                    else
-                        chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
-                    return SCPE_OK;
-                }
+            i = chan_write_block(chsa, buf, len);  /* put the sector to memory */
+            if (i != len) {
+                if (chp->chan_status & STATUS_PCHK)  /* test for memory error */
+                    uptr->SNS |= SNS_INAD;      /* invalid address */
+                sim_debug(DEBUG_EXP, dptr,
+                    "DISK READ4 %04x bytes leaving %04x from diskfile %04x/%02x/%02x\n",
+                    i, chp->ccw_count, ((uptr->CHS)>>16)&0xffff,
+                    ((uptr->CHS)>>8)&0xff, (uptr->CHS)&0xff);
+                uptr->CMD &= LMASK;             /* remove old status bits & cmd */
+                if (chp->chan_status & STATUS_PCHK)  /* test for memory error */
+                    chan_end(chsa, SNS_CHNEND|SNS_DEVEND|STATUS_PCHK);
+                else
+                    chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
+                return SCPE_OK;
             }
 
             /* get current sector offset */
@@ -2126,26 +2124,25 @@ domore_write:
 
             /* process the next sector of data */
             tcyl = 0;                           /* used here as a flag for short read */
-            for (i=0; i<ssize; i++) {
-                if (chan_read_byte(chsa, &ch)) {/* get a byte from memory */
+            i = chan_read_block(chsa, buf2, ssize);  /* get the sector from memory */
+            if (i != ssize) {
+                if (chp->chan_status & STATUS_PCHK)  /* test for memory error */
+                    uptr->SNS |= SNS_INAD;      /* invalid address */
+                /* if error on reading 1st byte, we are done writing */
+                if ((i == 0) || (chp->chan_status & STATUS_PCHK)) {
+                    uptr->CMD &= LMASK;         /* remove old status bits & cmd */
+                    sim_debug(DEBUG_EXP, dptr,
+                        "DISK Wrote %04x bytes to diskfile cyl %04x hds %02x sec %02x\n",
+                        ssize, STAR2CYL(uptr->CHS), ((uptr->CHS) >> 8)&0xff, (uptr->CHS&0xff));
                     if (chp->chan_status & STATUS_PCHK) /* test for memory error */
-                        uptr->SNS |= SNS_INAD;  /* invalid address */
-                    /* if error on reading 1st byte, we are done writing */
-                    if ((i == 0) || (chp->chan_status & STATUS_PCHK)) {
-                        uptr->CMD &= LMASK;     /* remove old status bits & cmd */
-                        sim_debug(DEBUG_EXP, dptr,
-                            "DISK Wrote %04x bytes to diskfile cyl %04x hds %02x sec %02x\n",
-                            ssize, STAR2CYL(uptr->CHS), ((uptr->CHS) >> 8)&0xff, (uptr->CHS&0xff));
-                        if (chp->chan_status & STATUS_PCHK) /* test for memory error */
-                            chan_end(chsa, SNS_CHNEND|SNS_DEVEND|STATUS_PCHK);
-                        else
-                            chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
-                        return SCPE_OK;
-                    }
-                    ch = 0;                     /* finish out the sector with zero */
-                    tcyl++;                     /* show we have no more data to write */
+                        chan_end(chsa, SNS_CHNEND|SNS_DEVEND|STATUS_PCHK);
+                    else
+                        chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
+                    return SCPE_OK;
                 }
-                buf2[i] = ch;                   /* save the char */
+                while (i < ssize)
+                    buf2[i++] = 0;              /* finish out the sector with zero */
+                tcyl++;                         /* show we have no more data to write */
             }
 
             /* get file offset in sectors */
@@ -61,6 +61,17 @@ LOCAL   uint32  SPAD[256];                  /* Scratch pad memory */
 /* Concept 32/X7 has 2048 2KW maps per task */
 LOCAL   uint32  MAPC[1024];                 /* maps are 16bit entries on word bountries */
 LOCAL   uint32  TLB[2048];                  /* Translated addresses for each map entry */
+/* Translation cache for RealAddr, holds decoded real page address and */
+/* the 1/4 page protection for recently used 2KW maps */
+#define TLBC_SIZE       64                  /* # of entries, must be power of 2 */
+#define TLBC_VALID      0x10000             /* entry is valid */
+#define TLBC_PRIV       0x20000             /* entry loaded in privileged mode */
+#define TLBC_UMIDL      0x40000             /* 32/27 & 32/87 check user midl */
+LOCAL   struct tlbc {
+    uint32  tag;                            /* map index and flags, 0 if empty */
+    uint32  base;                           /* real page address */
+    uint8   prot[4];                        /* protection for each 1/4 page */
+} TLBC[TLBC_SIZE];
 LOCAL   uint32  PC;                         /* Program counter */
 LOCAL   uint32  IR;                         /* Last Instruction */
 LOCAL   uint32  HIWM=0;                     /* max maps loaded so far */
@@ -575,6 +586,48 @@ LOCAL uint32 set_modes(uint32 psd[2])
 }
 #endif
 
+/* invalidate every entry in the translation cache */
+LOCAL void tlbc_flush_all(void)
+{
+    memset(TLBC, 0, sizeof(TLBC));                  /* clear all tags */
+}
+
+/* invalidate the translation cache entry for map number page */
+LOCAL void tlbc_flush(uint32 page)
+{
+    struct tlbc *tc = &TLBC[page & (TLBC_SIZE-1)];
+
+    if ((tc->tag & 0x7ff) == page)
+        tc->tag = 0;                                /* entry no longer valid */
+}
+
+/* enter a good translation for map index into the translation cache */
+/* raddr is the TLB entry for the map and map the MAPC entry */
+LOCAL void tlbc_load(uint32 index, uint32 raddr, uint32 map, uint32 flags)
+{
+    struct tlbc *tc = &TLBC[index & (TLBC_SIZE-1)];
+    uint32 i;
+
+    tc->tag = index | flags | TLBC_VALID;
+    if (MODES & PRIVBIT)
+        tc->tag |= TLBC_PRIV;                       /* only good in privileged mode */
+    tc->base = raddr & 0xffe000;                    /* real page address */
+    for (i = 0; i < 4; i++) {
+        if (CPU_MODEL < MODEL_V6) {
+            /* 27, 87, 67 & 97 have write protect bit for each 1/4 page */
+            if (((MODES & PRIVBIT) == 0) && ((BIT1 >> i) & raddr))
+                tc->prot[i] = 1;                    /* 1/4 page is write protected */
+            else
+                tc->prot[i] = 0;
+        } else {
+            /* V6 & V9 get access bits p1 & p2 from map */
+            tc->prot[i] = (map >> 12) & 0x6;
+            if (MODES & PRIVBIT)
+                tc->prot[i] |= 0x8;                 /* set priv bit */
+        }
+    }
+}
+
 /* set up the map registers for the current task in the ipu */
 /* the PSD bpix and cpix are used to setup the maps */
 /* return non-zero if mapping error */
@@ -595,6 +648,8 @@ LOCAL t_stat load_maps(uint32 thepsd[2], uint32 lmap)
         "Load Maps Entry PSD %08x %08x STATUS %08x lmap %1x IPU Mode %2x\n",
         thepsd[0], thepsd[1], IPUSTATUS, lmap, CPU_MODEL);
 
+    tlbc_flush_all();                               /* maps are changing, flush cache */
+
     /* process 32/7X computers */
     if (CPU_MODEL < MODEL_27) {
         MAXMAP = MAX32;                             /* 32 maps for 32/77 */
@@ -1117,6 +1172,7 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
     uint32  word, index, map, raddr, mpl, offset;
     uint32  nix, msdl, mix;
     uint32  MAXMAP = MAX2048;                       /* default to 2048 maps */
+    struct tlbc *tc;
 
     *prot = 0;      /* show unprotected memory as default */
                     /* unmapped mode is unprotected */
@@ -1190,6 +1246,21 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
 
     mpl = SPAD[0xf3] & MASK24;                      /* get 24 bit dbl wd mpl from spad address */
 
+    /* get 11 bit page number from address bits 8-18 */
+    index = (word >> 13) & 0x7ff;                   /* get 11 bit page value */
+    offset = word & 0x1fff;                         /* get 13 bit page offset */
+
+    /* see if translation is in the cache, if so skip the map decode */
+    tc = &TLBC[index & (TLBC_SIZE-1)];
+    if (((tc->tag & ~TLBC_UMIDL) == (index | TLBC_VALID |
+        ((MODES & PRIVBIT) ? TLBC_PRIV : 0))) &&
+        MEM_ADDR_OK(RMW(mpl+4) & MASK24) &&         /* O/S midl still good */
+        (((tc->tag & TLBC_UMIDL) == 0) || MEM_ADDR_OK(RMW(mpl+CPIX+4) & MASK24))) {
+        *realaddr = tc->base | offset;              /* return the real address */
+        *prot = tc->prot[offset >> 11];             /* protection for 1/4 page */
+        return ALLOK;                               /* all OK, return instruction */
+    }
+
     /* set maximum maps for 32/27 and 32/87 processors */
     if ((CPU_MODEL == MODEL_27) || (CPU_MODEL == MODEL_87))
         MAXMAP = MAX256;                            /* only 256 2KW (8kb) maps */
@@ -1223,10 +1294,6 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
     }
 
     /* we are mapped, so calculate real address from map information */
-    /* get 11 bit page number from address bits 8-18 */
-    index = (word >> 13) & 0x7ff;                   /* get 11 bit page value */
-    offset = word & 0x1fff;                         /* get 13 bit page offset */
-
     if (MODES & MAPMODE) {
         uint32 mpl = SPAD[0xf3];                    /* get mpl from spad address */
         uint32 cpix = CPIX;                         /* get cpix 11 bit offset from psd wd 2 */
@@ -1291,6 +1358,7 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
         }
         word = (raddr & 0xffe000) | offset;         /* combine real addr and offset */
         *realaddr = word;                           /* return the real address */
+        tlbc_load(index, raddr, map, TLBC_UMIDL);   /* save the translation */
         if (MODES & PRIVBIT)                        /* all OK if privledged */
             return ALLOK;                           /* all OK, return instruction */
 
@@ -1332,6 +1400,7 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
         map = RMR((index<<1));                      /* read the map reg contents */
         word = (raddr & 0xffe000) | offset;         /* combine map and offset */
         *realaddr = word;                           /* return the real address */
+        tlbc_load(index, raddr, map, 0);            /* save the translation */
 
         /* handle 32/67 & 32/97 protection here */
         if (CPU_MODEL < MODEL_V6) {
@@ -1458,6 +1527,7 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
     TLB[nix] = ((map & 0x7ff) << 13) | ((map << 16) & 0xf8000000) | 0x04000000;
     word = (TLB[nix] & 0xffe000) | offset;          /* combine map and offset */
     WMR((nix<<1), map);                             /* store the map reg contents into MAPC cache */
+    tlbc_flush(nix);                                /* drop any old translation */
     sim_debug(DEBUG_DETAIL, my_dev,
         "RealAddrm RMH %04x mix %04x TLB[%04x] %08x B+C %04x RMR[nix] %04x\n",
         map, mix, nix, TLB[nix], BPIX+CPIXPL, RMR(nix<<1));
@@ -1530,6 +1600,7 @@ LOCAL t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access
                     TLB[nix] = ((map & 0x7ff) << 13) | ((map << 16) & 0xf8000000) | 0x04000000;
                     word = (TLB[nix] & 0xffe000);   /* combine map and offset */
                     WMR((nix<<1), map);             /* store the map reg contents into MAPC cache */
+                    tlbc_flush(nix);                /* drop any old translation */
                     sim_debug(DEBUG_DETAIL, my_dev,
                         "Addr2b %06x RealAddr %06x Map2[%04x] HIT %04x, TLB[%3x] %08x MAPC[%03x] %08x\n",
                         addr, word, mix, map, nix, TLB[nix], nix/2, MAPC[nix/2]);
@@ -1625,6 +1696,7 @@ LOCAL t_stat Mem_read(uint32 addr, uint32 *data)
                 if (((map & 0x800) == 0)) {
                     map |= 0x800;                   /* set the accessed bit in the map cache entry */
                     WMR((page<<1), map);            /* store the map reg contents into cache */
+                    tlbc_flush(page);               /* drop any old translation */
                     TLB[page] |= 0x0c000000;        /* set the accessed bit in TLB too */
                     WMH(msdl+(mix<<1), map);        /* save modified map with access bit set */
                     sim_debug(DEBUG_DETAIL, my_dev,
@@ -1714,6 +1786,7 @@ LOCAL t_stat Mem_write(uint32 addr, uint32 *data)
                 if ((nmap & 0x1000) == 0) {
                     nmap |= 0x1800;                 /* set the modify/accessed bit in the map cache entry */
                     WMR((page<<1), nmap);           /* store the map reg contents into cache */
+                    tlbc_flush(page);               /* drop any old translation */
                     TLB[page] |= 0x18000000;        /* set the modify/accessed bits in TLB too */
                     WMH((msdl+(mix << 1)), nmap);   /* save modified map with access bit set */
                     sim_debug(DEBUG_DETAIL, my_dev,
@@ -1840,6 +1913,7 @@ reboot:                             /* cpu rebooting, so reinitialize ipu */
     PeerIndex = 0;
     IPC->pid[MyIndex] = 1;
     IPC->atrap[MyIndex] = 0;        /* clear trap value location */
+    tlbc_flush_all();               /* maps may have been changed by user */
 
     /* we will be running with an ipu, set it up */
     /* clear I/O and interrupt entries in SPAD. */
@@ -1929,8 +2003,7 @@ cond_go:                                            /* merge point when waiting
             /* interrupts must be unblocked to take the sipu trap */
             if (((IPUSTATUS & ONIPU) == 0) && IPC && ((IPUSTATUS & BIT24) == 0) &&
                 IPC->atrap[MyIndex]) {
-                TRAPME = IPC->atrap[MyIndex];
-                IPC->atrap[MyIndex] = 0;
+                TRAPME = ipc_get_trap(MyIndex);     /* get and clear trap */
                 IPC->received[MyIndex]++;
                 sim_debug(DEBUG_TRAP, my_dev, "%s: (%d) Async TRAP %02x SPAD[0xf0] %08x\n",
                     (IPUSTATUS & ONIPU) ? "IPU" : "CPU", __LINE__, TRAPME, SPAD[0xf0]);
@@ -1946,8 +2019,7 @@ cond_go:                                            /* merge point when waiting
             if ((IPUSTATUS & ONIPU) && ((IPUSTATUS & BIT24) == 0)) {
                 if (IPC && IPC->atrap[MyIndex]) {
                     wait4sipu = 0;                  /* wait is over for sipu */
-                    TRAPME = IPC->atrap[MyIndex];   /* get trap number */
-                    IPC->atrap[MyIndex] = 0;        /* clear flag */
+                    TRAPME = ipc_get_trap(MyIndex); /* get and clear trap */
                     IPC->received[MyIndex]++;
                     sim_debug(DEBUG_TRAP, my_dev, "%s: (%d) Async TRAP %02x SPAD[0xf0] %08x\n",
                         (IPUSTATUS & ONIPU) ? "IPU" : "CPU", __LINE__, TRAPME, SPAD[0xf0]);
@@ -1958,7 +2030,7 @@ cond_go:                                            /* merge point when waiting
                     goto newpsd;                    /* go process trap */
                 }
                 if (wait4sipu) {
-                    sim_os_ms_sleep(10);            /* wait 10 ms */
+                    ipc_wait_trap(MyIndex);         /* sleep until sipu */
                     goto wait_loop;                 /* continue waiting */
                 }
             }
@@ -1973,10 +2045,7 @@ cond_ok:
                 /* we are unblocked, look for SIPU */
                 /* we have a trap available, lock and get it */
                 if (IPC && IPC->atrap[MyIndex]) {
-                    lock_mutex();                   /* lock mutex */
-                    TRAPME = IPC->atrap[MyIndex];   /* get trap number */
-                    IPC->atrap[MyIndex] = 0;        /* clear trap value location */
-                    unlock_mutex();                 /* unlock mutex */
+                    TRAPME = ipc_get_trap(MyIndex); /* get and clear trap */
                     IPC->received[MyIndex]++;       /* count it received */
                     wait4sipu = 0;                  /* wait is over for sipu */
                     sim_debug(DEBUG_TRAP, my_dev, "IPU: (%d) Async TRAP %02x SPAD[0xf0] %02x rec'd %08x\n",
@@ -1993,10 +2062,7 @@ cond_ok:
             }
             /* unblocked and locked and no async trap */
             if (wait4sipu) {                        /* are we to wait */
-                lock_mutex();                       /* lock mutex */
-                while (IPC->atrap[MyIndex]==0)      /* sleep on the condition */
-                    pthread_cond_wait(&IPC->cond, &IPC->mutex); /* wait for wakeup */
-                unlock_mutex();                     /* unlock mutex and continue */
+                ipc_wait_trap(MyIndex);             /* sleep until sipu */
                 goto cond_ok;                       /* continue waiting */
             }
             /* not waiting for sipu, so continue processing */
@@ -2483,7 +2549,7 @@ exec2:
                     }
                     else {
 #ifdef USE_POSIX_SEM
-                        sim_os_ms_sleep(10);        /* wait 10 ms */
+                        ipc_wait_trap(MyIndex);     /* sleep until sipu */
                         goto wait_loop;             /* continue waiting */
 #else
                         wait4sipu = 1;              /* show we are waiting for SIPU */
@@ -2575,7 +2641,7 @@ exec2:
                             PSD1, PSD2, TRAPME, IPUSTATUS);
                     } else {
 #ifdef USE_POSIX_SEM
-                        sim_os_ms_sleep(10);        /* wait 10 ms */
+                        ipc_wait_trap(MyIndex);     /* sleep until sipu */
                         goto wait_loop;             /* continue waiting */
 #else
                         wait4sipu = 1;              /* show we are waiting for SIPU */
@@ -2697,43 +2763,15 @@ exec2:
 
                 if (CCW & HASIPU) {
                     /* CPU side = [0] IPU side = [1] */
-                    //GR if (IPC && IPC->atrap[PeerIndex]) {
-#ifdef USE_POSIX_SEM
-                    if (IPC->atrap[PeerIndex]) {
-                        /* previous atrap not yet handled */
-                        IPC->blocked[MyIndex]++;
-                        sim_debug(DEBUG_TRAP, my_dev,
-                            "%s: Async SIPU blocked IPUSTATUS %08x CCW %08x SPAD[0xf0] %08x\n",
-                            (IPUSTATUS & ONIPU)? "IPU": "CPU", IPUSTATUS, CCW, SPAD[0xf0]);
-
-                        //GR  Give it a millisec to unblock the atrap
-                        sim_os_ms_sleep(10);        /* wait 10 ms */
-                    }
-
-                    if (IPC->atrap[PeerIndex] == 0) {
-                        IPC->sent[MyIndex]++;
-                        IPC->atrap[PeerIndex] = SIGNALIPU_TRAP;
-                        sim_debug(DEBUG_TRAP, my_dev,
-                            "%s: Async SIPU sent IPUSTATUS %08x CCW %08x SPAD[0xf0] %08x\n",
-                            (IPUSTATUS & ONIPU)? "IPU": "CPU", IPUSTATUS, CCW, SPAD[0xf0]);
-                    }
-                    else
-                        IPC->dropped[MyIndex]++;
-#else
                     if (IPC->atrap[PeerIndex]) {
                         /* previous atrap not yet handled if not zero */
                         IPC->blocked[MyIndex]++;    /* count as blocked */
                         sim_debug(DEBUG_TRAP, my_dev,
                             "%s: Async SIPU blocked IPUSTATUS %08x CCW %08x SPAD[0xf0] %02x block %08x\n",
                             (IPUSTATUS & ONIPU)? "IPU": "CPU", IPUSTATUS, CCW, SPAD[0xf0], IPC->blocked[MyIndex]);
-                        //GR  Give it a millisec to unblock the atrap
-                        sim_os_ms_sleep(10);        /* wait 10 ms */
                     }
-                    if (IPC->atrap[PeerIndex] == 0) {
-                        lock_mutex();               /* lock mutex */
-                        IPC->atrap[PeerIndex] = SIGNALIPU_TRAP;
-                        pthread_cond_signal(&IPC->cond);    /* wake any waiters */
-                        unlock_mutex();             /* unlock mutex */
+                    /* post the trap, waits up to 10 ms for a full mailbox */
+                    if (ipc_post_trap(PeerIndex, SIGNALIPU_TRAP)) {
                         IPC->sent[MyIndex]++;
                         sim_debug(DEBUG_TRAP, my_dev,
                             "%s: Async SIPU sent IPUSTATUS %08x CCW %08x SPAD[0xf0] %02x sent %08x\n",
@@ -2744,7 +2782,6 @@ exec2:
                             "%s: Async SIPU sent IPUSTATUS %08x CCW %08x SPAD[0xf0] %02x drop %08x\n",
                             (IPUSTATUS & ONIPU)? "IPU": "CPU", IPUSTATUS, CCW, SPAD[0xf0], IPC->dropped[MyIndex]);
                     }
-#endif /* USE_POSIX_SEM */
                 } else {
                     sim_debug(DEBUG_TRAP, my_dev,
                     "SIPU IPUSTATUS %08x CCW %08x\n", IPUSTATUS, CCW);
@@ -4743,6 +4780,7 @@ doovr3:
                     Mmap |= 0x800;                  /* set the accessed bit in the map cache entry */
                     map |= 0x800;                   /* set the accessed bit in the memory map entry */
                     WMR((nix<<1), map);             /* store the map reg contents into cache */
+                    tlbc_flush(nix);                /* drop any old translation */
                     TLB[nix] |= 0x0c000000;         /* set the accessed & hit bits in TLB too */
                     WMH(msdl+(mix<<1), Mmap);       /* save modified memory map with access bit set */
                     sim_debug(DEBUG_EXP, my_dev,
@@ -6946,6 +6984,7 @@ t_stat ipu_reset(DEVICE *dptr)
             ival = 0xfffffff;                       /* init value for 32/7x int and dev entries */
         for (i = 0; i < 1024; i++)
             MAPC[i] = 0;                            /* clear 2048 halfword map cache */
+        tlbc_flush_all();                           /* clear the translation cache */
         for (i = 0; i < 224; i++)
             SPAD[i] = ival;                         /* init 128 devices and 96 ints in the spad */
         for (i = 224; i < 256; i++)                 /* clear the last 32 extries */
@@ -1045,11 +1045,12 @@ reread:
             bufp = dump_mem(m+32, 16);
             sim_debug(DEBUG_CMD, dptr, "mt_srv READ mem %s\n", bufp);
         }
-        /* get a char from the buffer */
-        ch = mt_buffer[bufnum][uptr->POS++];
-
-        /* Send character over to channel */
-        if (chan_write_byte(chsa, &ch)) {
+        /* Send the rest of the record over to channel */
+        uptr->POS += chan_write_block(chsa, &mt_buffer[bufnum][uptr->POS],
+            uptr->hwmark - uptr->POS);
+        if ((uint32)uptr->POS < uptr->hwmark) {
+            /* channel stopped before the end of the record */
+            ch = mt_buffer[bufnum][uptr->POS++];
             sim_debug(DEBUG_CMD, dptr,
                 "Read unit %02x EOR cnt %04x hwm %04x\n", unit, uptr->POS-1, uptr->hwmark);
             /* If not read whole record, skip till end */
@@ -1074,18 +1075,12 @@ reread:
             break;
 #endif
         } else {
-            sim_debug(DEBUG_DATA, dptr,
-                "Read data @2 unit %02x cnt %04x ch %02x hwm %04x\n",
-                unit, uptr->POS, ch, uptr->hwmark);
-            if ((uint32)uptr->POS >= uptr->hwmark) { /* In IRG */
-                /* Handle end of data record */
-                sim_debug(DEBUG_CMD, dptr,
-                    "Read end of data unit %02x cnt %04x ch %02x hwm %04x\n",
-                    unit, uptr->POS, ch, uptr->hwmark);
-                uptr->CMD |= MT_READDONE;   /* read is done */
-                goto reread;
-            } else
-                goto reread;
+            /* Handle end of data record */
+            sim_debug(DEBUG_CMD, dptr,
+                "Read end of data unit %02x cnt %04x hwm %04x\n",
+                unit, uptr->POS, uptr->hwmark);
+            uptr->CMD |= MT_READDONE;       /* read is done */
+            goto reread;
         }
         break;
 
@@ -1100,24 +1095,18 @@ reread:
             break;
         }
 
-rewrite:
         /* Grab data until channel has no more */
-        if (chan_read_byte(chsa, &ch)) {
-            if (uptr->POS > 0) {            /* Only if data in record */
-                reclen = uptr->hwmark;
-                sim_debug(DEBUG_CMD, dptr, "Write unit=%02x Block %04x chars\n",
-                    unit, reclen);
-                r = sim_tape_wrrecf(uptr, &mt_buffer[bufnum][0], reclen);
-                uptr->POS = 0;
-                uptr->CMD &= ~MT_CMDMSK;
-                mt_error(uptr, chsa, r, dptr);  /* Record errors */
-            }
-        } else {
-            mt_buffer[bufnum][uptr->POS++] = ch;
-            sim_debug(DEBUG_DATA, dptr, "Write data unit=%02x %04x %02x\n",
-                unit, uptr->POS, ch);
+        uptr->POS += chan_read_block(chsa, &mt_buffer[bufnum][uptr->POS],
+            BUFFSIZE - uptr->POS);
+        if (uptr->POS > 0) {                /* Only if data in record */
             uptr->hwmark = uptr->POS;
-            goto rewrite;
+            reclen = uptr->hwmark;
+            sim_debug(DEBUG_CMD, dptr, "Write unit=%02x Block %04x chars\n",
+                unit, reclen);
+            r = sim_tape_wrrecf(uptr, &mt_buffer[bufnum][0], reclen);
+            uptr->POS = 0;
+            uptr->CMD &= ~MT_CMDMSK;
+            mt_error(uptr, chsa, r, dptr);  /* Record errors */
         }
         break;
 
@@ -1068,16 +1068,14 @@ doread:
                 chsa, chp->ccw_count);
 
             /* process the sector of data */
-            for (i=0; i<len; i++) {
-                ch = buf[i];                    /* get a char from buffer */
-                if (chan_write_byte(chsa, &ch)) {   /* put a byte to memory */
-                    sim_debug(DEBUG_DATA, dptr,
-                        "SCSI Read %04x bytes leaving %04x from diskfile sector %06x\n",
-                        i, chp->ccw_count, tstart);
-                    uptr->CMD &= LMASK;         /* remove old status bits & cmd */
-                    chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
-                    return SCPE_OK;
-                }
+            i = chan_write_block(chsa, buf, len);  /* put the sector to memory */
+            if (i != len) {
+                sim_debug(DEBUG_DATA, dptr,
+                    "SCSI Read %04x bytes leaving %04x from diskfile sector %06x\n",
+                    i, chp->ccw_count, tstart);
+                uptr->CMD &= LMASK;             /* remove old status bits & cmd */
+                chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
+                return SCPE_OK;
             }
 
             sim_debug(DEBUG_CMD, dptr,
@@ -1258,21 +1256,20 @@ dowrite:
 
             /* process the next sector of data */
             len = 0;                            /* used here as a flag for short read */
-            for (i=0; i<ssize; i++) {
-                if (chan_read_byte(chsa, &ch)) {/* get a byte from memory */
-                    /* if error on reading 1st byte, we are done writing */
-                    if (i == 0) {
-                        uptr->CMD &= LMASK;     /* remove old status bits & cmd */
-                        sim_debug(DEBUG_CMD, dptr,
-                            "SCSI Wrote %04x bytes to diskfile sector %06x\n",
-                            ssize, tstart);
-                        chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
-                        return SCPE_OK;
-                    }
-                    ch = 0;                     /* finish out the sector with zero */
-                    len++;                      /* show we have no more data to write */
+            i = chan_read_block(chsa, buf2, ssize);  /* get the sector from memory */
+            if (i != ssize) {
+                /* if error on reading 1st byte, we are done writing */
+                if (i == 0) {
+                    uptr->CMD &= LMASK;         /* remove old status bits & cmd */
+                    sim_debug(DEBUG_CMD, dptr,
+                        "SCSI Wrote %04x bytes to diskfile sector %06x\n",
+                        ssize, tstart);
+                    chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
+                    return SCPE_OK;
                 }
-                buf2[i] = ch;                   /* save the char */
+                while (i < ssize)
+                    buf2[i++] = 0;              /* finish out the sector with zero */
+                len++;                          /* show we have no more data to write */
             }
 
             /* write the sector to disk */
@@ -41,9 +41,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
-#include <limits.h>         /* for USHRT_MAX */
+#include <string.h>         /* for memcpy */
+#include <limits.h>         /* for SHRT_MAX */
 #include "ws.h"
 #include "display.h"
+
+/*
+ * When built with SDL (the simh window system layer) drawing is split
+ * off into a render thread; see display_point() and render_loop().
+ * Define DISPLAY_NO_THREAD to draw synchronously from the caller.
+ */
+#if defined(HAVE_LIBSDL) && !defined(DISPLAY_NO_THREAD)
+#define DISPLAY_THREAD 1
+#include <SDL.h>
+#endif
 
 /*
  * The user may select (at compile time) how big a window is used to
@@ -271,12 +282,11 @@ static struct display displays[] = {
 };
 
 /*
- * Unit time (in microseconds) used to store display point time to
- * live at current aging level.  If this is too small, delay values
- * cannot fit in an unsigned short.  If it is too large all pixels
- * will age at once.  Perhaps a suitable value should be calculated at
- * run time?  When display_init() calculates refresh_interval it
- * sanity checks for both cases.
+ * Unit time (in microseconds) used to measure the interval between
+ * aging passes.  If it is too large the interval rounds down to
+ * nothing.  Perhaps a suitable value should be calculated at run
+ * time?  When display_init() calculates refresh_interval it sanity
+ * checks for this.
  */
 #define DELAY_UNIT 250
 
@@ -330,59 +340,39 @@ static struct display displays[] = {
  */
 
 /*
- * Each point on the display is represented by a "struct point".  When
- * a point isn't dark (intensity > 0), it is linked into a circular,
- * doubly linked delta queue (a priority queue where "delay"
- * represents the time difference from the previous entry (if any) in
- * the queue.
+ * Each point on the display is represented by one byte in each of two
+ * planes: the time to live (zero means dark) and the intensity level
+ * and beam color it was last drawn with.
  *
- * All points are aged refresh_rate times/second, each time moved to the
- * next (logarithmically) lower intensity level.  When display_age() is
- * called, only the entries which have expired are processed.  Calling
- * display_age() often allows spreading out the workload.
+ * All points are aged together refresh_rate times/second, each time
+ * moved to the next (logarithmically) lower intensity level.  An aging
+ * pass only walks the rows known to hold lit points and skips dark
+ * stretches of a row a word at a time, so a mostly dark screen costs
+ * little.  A point drawn part way through an interval is aged at the
+ * end of that interval rather than a full interval after it was drawn.
  *
  * An alternative would be to have intensity levels represent linear
  * decreases in intensity, and have the decay time at each level change.
  * Inverting the decay function for a multi-component phosphor may be
  * tricky, and the two different colors would need different time tables.
- * Furthermore, it would require finding the correct location in the
- * queue when adding a point (currently only need to add points at end)
  */
 
 /*
- * 12 bytes/entry on 32-bit system when REFRESH_RATE > 15
- * (requires 3MB for 512x512 display).
+ * 2 bytes/pixel (512KB for a 512x512 display).
  */
 
-typedef unsigned short delay_t;
-#define DELAY_T_MAX USHRT_MAX
+static unsigned char *ttls;     /* per-pixel time to live */
+static unsigned char *attrs;    /* per-pixel intensity level and color */
+static volatile long lit;       /* number of lit points */
+static int lit_ymin, lit_ymax;  /* range of rows holding lit points */
 
-struct point {
-    struct point *next;         /* next entry in queue */
-    struct point *prev;         /* prev entry in queue */
-    delay_t delay;              /* delta T in DELAY_UNITs */
-    unsigned char ttl;          /* zero means off, not linked in */
-    unsigned char level : 7;    /* intensity level */
-    unsigned char color : 1;    /* for VR20 (two colors) */
-};
+/* pack and unpack an attrs entry */
+#define ATTR(L,C) ((unsigned char)((L) | ((C) << 7)))
+#define LEVEL(A) ((A) & 0x7f)
+#define COLOR(A) (((A) >> 7) & 1)
 
-static struct point *points;    /* allocated array of points */
-static struct point _head;
-#define head (&_head)
-
-/*
- * time span of all entries in queue
- * should never exceed refresh_interval
- * (should be possible to make this a delay_t)
- */
-static long queue_interval;
-
-/* convert X,Y to a "struct point *" */
-#define P(X,Y) (points + (X) + ((Y)*(size_t)xpixels))
-
-/* convert "struct point *" to X and Y */
-#define X(P) (((P) - points) % xpixels)
-#define Y(P) (((P) - points) / xpixels)
+/* offset of X,Y in the planes */
+#define P(X,Y) ((X) + ((Y)*(size_t)xpixels))
 
 static int initialized = 0;
 static void *device = NULL;  /* Current display device. */
@@ -425,6 +415,44 @@ static float level_scale[NLEVELS];
  * for painting each age level, intensity level and beam color
  */
 void *colors[2][NLEVELS][NTTL];
+
+#ifdef DISPLAY_THREAD
+/*
+ * display_point() and display_line() append runs of points to a single
+ * producer, single consumer ring and return; the render thread
+ * drains it, ages the phosphor against
+ * wall clock time and hands at most FRAME_RATE frames/second to the
+ * window system.  Only the render thread touches the pixel planes once
+ * it is running.
+ *
+ * Neither side polls: the render thread sleeps on ring_work while the
+ * ring is empty (bounded by the next frame only while something is
+ * still lit), and display_point() sleeps on ring_space when the ring is
+ * full.  Each side only takes ring_lock to signal when the other has
+ * flagged that it is (about to be) asleep, so the fast path is lock free.
+ */
+#define RING_SIZE 65536         /* entries, power of two */
+#define FRAME_RATE 60           /* frames/second presented */
+
+struct ring_entry {
+    int x, y;                   /* first point (unscaled) */
+    short n;                    /* number of points */
+    signed char ix, iy;         /* step between points */
+    unsigned char level;
+    unsigned char color;
+};
+
+static struct ring_entry ring[RING_SIZE];
+static SDL_atomic_t ring_head;  /* next entry written by display_point */
+static SDL_atomic_t ring_tail;  /* next entry read by render_loop */
+static SDL_atomic_t render_run; /* cleared to stop render_loop */
+static SDL_atomic_t render_idle; /* render_loop waiting on ring_work */
+static SDL_atomic_t queue_full; /* display_point waiting on ring_space */
+static SDL_mutex *ring_lock;
+static SDL_cond *ring_work;     /* points queued */
+static SDL_cond *ring_space;    /* entries freed */
+static SDL_Thread *render_thread;
+#endif /* DISPLAY_THREAD defined */
 
 void
 display_lp_radius(int r)
@@ -434,45 +462,66 @@ display_lp_radius(int r)
 }
 
 /*
- * from display_age and display_point
- * since all points age at the same rate,
- * only adds points at end of list.
+ * from display_age
+ * move every lit point to its next lower intensity level.
+ * returns true if anything changed.
  */
-static void
-queue_point(struct point *p)
+static int
+age_points(void)
 {
-    int d;
-
-    d = refresh_interval - queue_interval;
-    queue_interval += d;
-    /* queue_interval should now be == refresh_interval */
-
-#ifdef PARANOIA
-    if (p->ttl == 0 || p->ttl > MAXTTL)
-    printf("queuing %d,%d level %d!\n", X(p), Y(p), p->level);
-    if (d > DELAY_T_MAX)
-    printf("queuing %d,%d delay %d!\n", X(p), Y(p), d);
-    if (queue_interval > DELAY_T_MAX)
-    printf("queue_interval (%d) > DELAY_T_MAX (%d)\n",
-           (int)queue_interval, DELAY_T_MAX);
-#endif /* PARANOIA defined */
-
-    p->next = head;
-    p->prev = head->prev;
-
-    head->prev->next = p;
-    head->prev = p;
-
-    p->delay = d;
+    int x, y;
+    int ymin = ypixels, ymax = -1;
+    int changed = 0;
+
+    for (y = lit_ymin; y <= lit_ymax; y++) {
+        unsigned char *row = ttls + P(0,y);
+        unsigned char *arow = attrs + P(0,y);
+        int rowlit = 0;
+
+        for (x = 0; x < xpixels; x++) {
+            unsigned long w;
+            unsigned char ttl;
+
+            /* skip dark stretches a word at a time */
+            if (x + (int)sizeof(w) <= xpixels) {
+                memcpy(&w, row + x, sizeof(w));
+                if (w == 0) {
+                    x += sizeof(w) - 1;
+                    continue;
+                    }
+                }
+            if ((ttl = row[x]) == 0)
+                continue;
+            row[x] = --ttl;
+            ws_display_point(x, y, colors[COLOR(arow[x])][LEVEL(arow[x])][ttl]);
+            changed = 1;
+            if (ttl)
+                rowlit = 1;
+            else
+                lit--;
+            }
+        if (rowlit) {
+            if (ymin > y)
+                ymin = y;
+            ymax = y;
+            }
+        }
+    lit_ymin = ymin;
+    lit_ymax = ymax;
+    return changed;
 }
 
 /*
- * Return true if the display is blank, i.e. no active points in list.
+ * Return true if the display is blank, i.e. no lit points.
  */
 int
 display_is_blank(void)
 {
-    return head->next == head;
+#ifdef DISPLAY_THREAD
+    if (SDL_AtomicGet(&ring_head) != SDL_AtomicGet(&ring_tail))
+        return 0;               /* points still on their way */
+#endif
+    return lit == 0;
 }
 
 /*
@@ -641,9 +690,9 @@ int
 display_age(int t,          /* simulated us since last call */
         int slowdown)       /* slowdown to simulated speed */
 {
-    struct point *p;
     static int elapsed = 0;
     static int refresh_elapsed = 0; /* in units of DELAY_UNIT bounded by refresh_interval */
+    static int age_elapsed = 0;     /* in units of DELAY_UNIT since last aging pass */
     int changed;
 
     if (!initialized && !display_init(DISPLAY_TYPE, PIX_SCALE, NULL))
@@ -667,36 +716,19 @@ display_age(int t,          /* simulated us since last call */
         refresh_elapsed = 0;
         }
 
-    while ((p = head->next) != head) {
-        int x, y;
-
-        /* look at oldest entry */
-        if (p->delay > t) {         /* further than our reach? */
-            p->delay -= t;          /* update head */
-            queue_interval -= t;    /* update span */
-            break;                  /* quit */
-            }
-
-        x = X(p);
-        y = Y(p);
-#ifdef PARANOIA
-        if (p->ttl == 0)
-            printf("BUG: age %d,%d ttl zero\n", x, y);
-#endif /* PARANOIA defined */
-
-        /* dequeue point */
-        p->prev->next = p->next;
-        p->next->prev = p->prev;
-
-        t -= p->delay;              /* lessen our reach */
-        queue_interval -= p->delay; /* update queue span */
-
-        ws_display_point(x, y, colors[p->color][p->level][--p->ttl]);
-        changed = 1;
-
-        /* queue it back up, unless we just turned it off! */
-        if (p->ttl > 0)
-            queue_point(p);
+#ifdef DISPLAY_THREAD
+    if (render_thread)          /* render thread does the aging */
+        return !display_is_blank();
+#endif
+    age_elapsed += t;
+    if (age_elapsed >= refresh_interval) {
+        int passes = age_elapsed / refresh_interval;
+
+        age_elapsed %= refresh_interval;
+        if (passes > MAXTTL)        /* everything is dark by then */
+            passes = MAXTTL;
+        while (passes-- > 0 && lit > 0)
+            changed |= age_points();
         }
     return changed;
 } /* display_age */
@@ -704,15 +736,15 @@ display_age(int t,          /* simulated us since last call */
 /* here from window system */
 void
 display_repaint(void) {
-    struct point *p;
+    size_t i;
     int x, y;
     /*
      * bottom to top, left to right.
      */
-    for (p = points, y = 0; y < ypixels; y++)
-        for (x = 0; x < xpixels; p++, x++)
-            if (p->ttl)
-                ws_display_point(x, y, colors[p->color][p->level][p->ttl-1]);
+    for (i = 0, y = 0; y < ypixels; y++)
+        for (x = 0; x < xpixels; i++, x++)
+            if (ttls[i])
+                ws_display_point(x, y, colors[COLOR(attrs[i])][LEVEL(attrs[i])][ttls[i]-1]);
     ws_sync();
 }
 
@@ -723,36 +755,38 @@ intensify(int x,            /* 0..xpixels */
       int level,            /* 0..MAXLEVEL */
       int color)            /* for VR20! 0 or 1 */
 {
-    struct point *p;
+    size_t i;
+    int ttl, plevel, pcolor;
     int bleed;
 
     if (x < 0 || x >= xpixels || y < 0 || y >= ypixels)
         return 0;           /* limit to display */
 
-    p = P(x,y);
-    if (p->ttl) {           /* currently lit? */
+    i = P(x,y);
+    ttl = ttls[i];
+    plevel = LEVEL(attrs[i]);
+    pcolor = COLOR(attrs[i]);
+    if (ttl) {              /* currently lit? */
 #ifdef LOUD
         printf("%d,%d old level %d ttl %d new %d\r\n",
-               x, y, p->level, p->ttl, level);
+               x, y, plevel, ttl, level);
 #endif /* LOUD defined */
-
-        /* unlink from delta queue */
-        p->prev->next = p->next;
-
-        if (p->next == head)
-            queue_interval -= p->delay;
-        else
-            p->next->delay += p->delay;
-        p->next->prev = p->prev;
+        }
+    else {                  /* newly lit */
+        lit++;
+        if (y < lit_ymin)
+            lit_ymin = y;
+        if (y > lit_ymax)
+            lit_ymax = y;
         }
 
     bleed = 0;              /* no bleeding for now */
 
     /* EXP: doesn't work... yet */
     /* if "recently" drawn, same or brighter, same color, make even brighter */
-    if (p->ttl >= MAXTTL*2/3 && 
-        level >= p->level && 
-        p->color == color &&
+    if (ttl >= MAXTTL*2/3 && 
+        level >= plevel && 
+        pcolor == color &&
         level < MAXLEVEL)
         level++;
 
@@ -760,26 +794,222 @@ intensify(int x,            /* 0..xpixels */
      * this allows a dim beam to suck light out of
      * a recently drawn bright spot!!
      */
-    if (p->ttl != MAXTTL || p->level != level || p->color != color) {
-        p->ttl = MAXTTL;
-        p->level = level;
-        p->color = color;   /* save color even if monochrome */
-        ws_display_point(x, y, colors[p->color][p->level][p->ttl-1]);
+    if (ttl != MAXTTL || plevel != level || pcolor != color) {
+        ttls[i] = MAXTTL;
+        attrs[i] = ATTR(level, color);  /* save color even if monochrome */
+        ws_display_point(x, y, colors[color][level][MAXTTL-1]);
         }
-
-    queue_point(p);         /* put at end of list */
     return bleed;
 }
+
+/* scale an x or y coordinate to the displayed number of pixels */
+#define SCALE(V) (scale == 2 ? (V) >> 1 : (V) / scale)
+
+/*
+ * intensify n points (unscaled) starting at x,y, stepping by ix,iy.
+ * the points are visited in order, so overlapping points after
+ * scaling brighten exactly as if drawn one at a time.
+ */
+static void
+intensify_run(int x, int y, int n, int ix, int iy, int level, int color)
+{
+    if (scale == 1) {
+        for (; n > 0; n--, x += ix, y += iy)
+            intensify(x, y, level, color);
+        }
+    else {
+        for (; n > 0; n--, x += ix, y += iy)
+            intensify(SCALE(x), SCALE(y), level, color);
+        }
+}
 
-int
-display_point(int x,        /* 0..xpixels (unscaled) */
-          int y,            /* 0..ypixels (unscaled) */
-          int level,        /* DISPLAY_INT_xxx */
-          int color)        /* for VR20! 0 or 1 */
+#ifdef DISPLAY_THREAD
+/*
+ * store a ring index or flag owned by the caller.  The compare and
+ * swap always succeeds (single writer) and, unlike a plain atomic set,
+ * is a full barrier: the store is visible before the caller then reads
+ * the other side's flag, so a wakeup can't be missed.
+ */
+static void
+ring_set(SDL_atomic_t *a, int v)
+{
+    SDL_AtomicCAS(a, SDL_AtomicGet(a), v);
+}
+
+/* wake the other side if it said it was waiting on cond */
+static void
+ring_wake(SDL_atomic_t *waiting, SDL_cond *cond)
+{
+    if (SDL_AtomicGet(waiting)) {
+        SDL_LockMutex(ring_lock);
+        SDL_CondSignal(cond);
+        SDL_UnlockMutex(ring_lock);
+        }
+}
+
+static int
+render_loop(void *arg)
+{
+    Uint32 now, last_age, last_frame;
+    long age_us = 0;
+    long interval_us = (long)refresh_interval * DELAY_UNIT;
+    int dirty = 0;
+
+    last_age = last_frame = SDL_GetTicks();
+    while (SDL_AtomicGet(&render_run)) {
+        int head = SDL_AtomicGet(&ring_head);
+        int tail = SDL_AtomicGet(&ring_tail);
+
+        SDL_MemoryBarrierAcquire();
+        if (tail != head) {
+            while (tail != head) {
+                struct ring_entry *e = &ring[tail];
+
+                intensify_run(e->x, e->y, e->n, e->ix, e->iy,
+                              e->level, e->color);
+                tail = (tail + 1) & (RING_SIZE - 1);
+                }
+            ring_set(&ring_tail, tail);
+            ring_wake(&queue_full, ring_space);
+            dirty = 1;
+            }
+
+        now = SDL_GetTicks();
+        age_us += (long)(now - last_age) * 1000;
+        last_age = now;
+        if (age_us >= interval_us) {
+            long passes = age_us / interval_us;
+
+            age_us %= interval_us;
+            if (passes > MAXTTL)    /* everything is dark by then */
+                passes = MAXTTL;
+            while (passes-- > 0 && lit > 0)
+                dirty |= age_points();
+            }
+
+        if (dirty && (now - last_frame) >= 1000/FRAME_RATE) {
+            ws_sync();
+            last_frame = now;
+            dirty = 0;
+            }
+
+        /*
+         * sleep until more points are queued; while anything is still
+         * lit wake up for the next frame to age it, otherwise for good
+         */
+        SDL_LockMutex(ring_lock);
+        ring_set(&render_idle, 1);
+        if (tail == SDL_AtomicGet(&ring_head) && SDL_AtomicGet(&render_run)) {
+            if (lit > 0 || dirty) {
+                Uint32 since = SDL_GetTicks() - last_frame;
+
+                SDL_CondWaitTimeout(ring_work, ring_lock,
+                                    since < 1000/FRAME_RATE ?
+                                    1000/FRAME_RATE - since : 1);
+                }
+            else
+                SDL_CondWait(ring_work, ring_lock);
+            }
+        ring_set(&render_idle, 0);
+        SDL_UnlockMutex(ring_lock);
+        }
+    return 0;
+}
+
+/* from plot_run, on the simulator thread */
+static void
+render_queue(int x, int y, int n, int ix, int iy, int level, int color)
+{
+    int head, next;
+
+    head = SDL_AtomicGet(&ring_head);
+    next = (head + 1) & (RING_SIZE - 1);
+    if (next == SDL_AtomicGet(&ring_tail)) {
+        /* full, sleep until the renderer catches up */
+        SDL_LockMutex(ring_lock);
+        ring_set(&queue_full, 1);
+        while (next == SDL_AtomicGet(&ring_tail))
+            SDL_CondWait(ring_space, ring_lock);
+        ring_set(&queue_full, 0);
+        SDL_UnlockMutex(ring_lock);
+        }
+    ring[head].x = x;
+    ring[head].y = y;
+    ring[head].n = (short)n;
+    ring[head].ix = (signed char)ix;
+    ring[head].iy = (signed char)iy;
+    ring[head].level = (unsigned char)level;
+    ring[head].color = (unsigned char)color;
+    SDL_MemoryBarrierRelease();
+    ring_set(&ring_head, next);
+    ring_wake(&render_idle, ring_work);
+}
+
+static void
+render_free(void)
+{
+    if (ring_space)
+        SDL_DestroyCond(ring_space);
+    if (ring_work)
+        SDL_DestroyCond(ring_work);
+    if (ring_lock)
+        SDL_DestroyMutex(ring_lock);
+    ring_space = ring_work = NULL;
+    ring_lock = NULL;
+}
+
+static void
+render_start(void)
+{
+    SDL_AtomicSet(&ring_head, 0);
+    SDL_AtomicSet(&ring_tail, 0);
+    SDL_AtomicSet(&render_idle, 0);
+    SDL_AtomicSet(&queue_full, 0);
+    SDL_AtomicSet(&render_run, 1);
+    ring_lock = SDL_CreateMutex();
+    ring_work = SDL_CreateCond();
+    ring_space = SDL_CreateCond();
+    if (ring_lock && ring_work && ring_space)
+        render_thread = SDL_CreateThread(render_loop, "display-render", NULL);
+    if (!render_thread)         /* just draw from the simulator thread */
+        render_free();
+}
+
+static void
+render_stop(void)
+{
+    if (!render_thread)
+        return;
+    SDL_LockMutex(ring_lock);
+    SDL_AtomicSet(&render_run, 0);
+    SDL_CondSignal(ring_work);
+    SDL_UnlockMutex(ring_lock);
+    SDL_WaitThread(render_thread, NULL);
+    render_thread = NULL;
+    render_free();
+}
+#endif /* DISPLAY_THREAD defined */
+
+/* draw a run of points (unscaled), here or on the render thread */
+static void
+plot_run(int x, int y, int n, int ix, int iy, int level, int color)
+{
+#ifdef DISPLAY_THREAD
+    if (render_thread) {
+        render_queue(x, y, n, ix, iy, level, color);
+        return;
+        }
+#endif
+    intensify_run(x, y, n, ix, iy, level, color);
+}
+
+/* true if the light pen is at (or very near) x,y (unscaled) */
+static int
+lp_hit(int x, int y)
 {
     long lx, ly;
 
-    if (!initialized && !display_init(DISPLAY_TYPE, PIX_SCALE, NULL))
+    if (ws_lp_x == -1 || ws_lp_y == -1)
         return 0;
 
     /* scale x and y to the displayed number of pixels */
@@ -795,36 +1025,109 @@ display_point(int x,        /* 0..xpixels (unscaled) */
             }
         }
 
+    lx = x - ws_lp_x;
+    ly = y - ws_lp_y;
+    return lx*lx + ly*ly <= scaled_pen_radius_squared;
+}
+
+int
+display_point(int x,        /* 0..xpixels (unscaled) */
+          int y,            /* 0..ypixels (unscaled) */
+          int level,        /* DISPLAY_INT_xxx */
+          int color)        /* for VR20! 0 or 1 */
+{
+    if (!initialized && !display_init(DISPLAY_TYPE, PIX_SCALE, NULL))
+        return 0;
+
 #if DISPLAY_INT_MIN > 0
     level -= DISPLAY_INT_MIN;       /* make zero based */
 #endif
-    intensify(x, y, level, color);
+    plot_run(x, y, 1, 0, 0, level, color);
     /* no bleeding for now (used to recurse for neighbor points) */
 
-    if (ws_lp_x == -1 || ws_lp_y == -1)
-        return 0;
-
-    lx = x - ws_lp_x;
-    ly = y - ws_lp_y;
-    return lx*lx + ly*ly <= scaled_pen_radius_squared;
+    return lp_hit(x, y);
 } /* display_point */
 
 #define ABS(_X) ((_X) >= 0 ? (_X) : -(_X))
 #define SIGN(_X) ((_X) >= 0 ? 1 : -1)
 
+/*
+ * display_line() and display_run_point() collect consecutive points
+ * that advance by the same step into runs, and draw each run with one
+ * plot_run() call rather than a display_point() call per point.
+ * The step has to fit the signed char in a ring entry.
+ */
+#define RUN_STEP(D) ((D) >= -127 && (D) <= 127)
+
+void
+display_run_flush(struct display_run *r)
+{
+    if (r->n)
+        plot_run(r->x, r->y, r->n, r->ix, r->iy, r->level, r->color);
+    r->n = 0;
+}
+
+/* level is zero based here */
+static void
+run_point(struct display_run *r, int x, int y, int level, int color)
+{
+    if (r->n && (level != r->level || color != r->color))
+        display_run_flush(r);
+    if (r->n == 1 && RUN_STEP(x - r->x) && RUN_STEP(y - r->y)) {
+        r->ix = x - r->x;       /* second point sets the step */
+        r->iy = y - r->y;
+        r->nx = x + r->ix;
+        r->ny = y + r->iy;
+        r->n = 2;
+        return;
+        }
+    if (r->n > 1 && x == r->nx && y == r->ny && r->n < SHRT_MAX) {
+        r->nx += r->ix;
+        r->ny += r->iy;
+        r->n++;
+        return;
+        }
+    display_run_flush(r);
+    r->x = x;
+    r->y = y;
+    r->n = 1;
+    r->ix = r->iy = 0;
+    r->level = level;
+    r->color = color;
+}
+
+int
+display_run_point(struct display_run *r,
+          int x,            /* 0..xpixels (unscaled) */
+          int y,            /* 0..ypixels (unscaled) */
+          int level,        /* DISPLAY_INT_xxx */
+          int color)        /* for VR20! 0 or 1 */
+{
+    if (!initialized && !display_init(DISPLAY_TYPE, PIX_SCALE, NULL))
+        return 0;
+
+#if DISPLAY_INT_MIN > 0
+    level -= DISPLAY_INT_MIN;       /* make zero based */
+#endif
+    run_point(r, x, y, level, color);
+    return lp_hit(x, y);
+} /* display_run_point */
+
 static void
 xline (int x, int y, int x2, int dx, int dy, int level)
 {
     int ix = SIGN(dx);
     int iy = SIGN(dy);
     int ay;
+    struct display_run r;
 
     dx = ABS(dx);
     dy = ABS(dy);
 
+    r.n = 0;
     ay = dy/2;
     for (;;) {
-        display_point (x, y, level, 0);
+        run_point (&r, x, y, level, 0);
         if (x == x2)
             break;
         if (ay > 0) {
@@ -834,6 +1137,7 @@ xline (int x, int y, int x2, int dx, int dy, int level)
         ay += dy;
         x += ix;
     }
+    display_run_flush (&r);
 }
   
 static void
@@ -842,13 +1146,15 @@ yline (int x, int y, int y2, int dx, int dy, int level)
     int ix = SIGN(dx);
     int iy = SIGN(dy);
     int ax;
+    struct display_run r;
 
     dx = ABS(dx);
     dy = ABS(dy);
 
+    r.n = 0;
     ax = dx/2;
     for (;;) {
-        display_point (x, y, level, 0);
+        run_point (&r, x, y, level, 0);
         if (y == y2)
             break;
         if (ax > 0) {
@@ -858,6 +1164,7 @@ yline (int x, int y, int y2, int dx, int dy, int level)
         ax += dx;
         y += iy;
     }
+    display_run_flush (&r);
 }
 
 void
@@ -869,6 +1176,13 @@ display_line(int x1,        /* 0..xpixels (unscaled) */
 {
     int dx = x2 - x1;
     int dy = y2 - y1;
+
+    if (!initialized && !display_init(DISPLAY_TYPE, PIX_SCALE, NULL))
+        return;
+
+#if DISPLAY_INT_MIN > 0
+    level -= DISPLAY_INT_MIN;       /* make zero based */
+#endif
     if (ABS (dx) > ABS(dy))
         xline (x1, y1, x2, dx, dy, level);
     else
@@ -979,9 +1293,6 @@ display_init(enum display_type type, int sf, void *dptr)
         goto failed;
         }
 
-    /* Initialize display list */
-    head->next = head->prev = head;
-
     display_type = type;
     scale = sf;
 
@@ -992,6 +1303,11 @@ display_init(enum display_type type, int sf, void *dptr)
     xpixels = xpoints / scale;
     ypixels = ypoints / scale;
 
+    /* nothing lit yet */
+    lit = 0;
+    lit_ymin = ypixels;
+    lit_ymax = -1;
+
     /* set default pen radius now that scale is set */
     display_lp_radius(PEN_RADIUS);
 
@@ -1028,14 +1344,6 @@ display_init(enum display_type type, int sf, void *dptr)
         refresh_interval = 1;
         }
 
-    /* point lifetime in DELAY_UNITs will not fit in p->delay field! */
-    if (refresh_interval > DELAY_T_MAX) {
-        /* increase DELAY_UNIT? */
-        fprintf(stderr, "bad refresh_interval %d > DELAY_T_MAX %d\r\n",
-            refresh_interval, DELAY_T_MAX);
-        goto failed;
-        }
-
     /*
      * before phosphor_init;
      * set up relative brightness of display intensity levels
@@ -1047,10 +1355,14 @@ display_init(enum display_type type, int sf, void *dptr)
     for (i = 0; i < NLEVELS; i++)
         level_scale[i] = ((float)i+1+BOOST)/(NLEVELS+BOOST);
 
-    points = (struct point *)calloc((size_t)xpixels,
-                    ypixels * sizeof(struct point));
-    if (!points)
+    ttls = (unsigned char *)calloc((size_t)xpixels, ypixels);
+    attrs = (unsigned char *)calloc((size_t)xpixels, ypixels);
+    if (!ttls || !attrs) {
+        free(ttls);
+        free(attrs);
+        ttls = attrs = NULL;
         goto failed;
+        }
 
     if (!ws_init(dp->name, xpixels, ypixels, ncolors, dptr))
         goto failed;
@@ -1061,6 +1373,9 @@ display_init(enum display_type type, int sf, void *dptr)
         phosphor_init(dp->color1->phosphors, dp->color1->nphosphors, 1);
 
     initialized = 1;
+#ifdef DISPLAY_THREAD
+    render_start();
+#endif
     init_failed = 0;            /* hey, we made it! */
     device = dptr;
     return 1;
@@ -1079,7 +1394,12 @@ display_close(void *dptr)
     if (device != dptr)
         return;
 
-    free (points);
+#ifdef DISPLAY_THREAD
+    render_stop();
+#endif
+    free (ttls);
+    free (attrs);
+    ttls = attrs = NULL;
     ws_shutdown();
 
     initialized = 0;
@@ -1096,6 +1416,10 @@ void
 display_sync(void)
 {
     ws_poll (NULL, 0);
+#ifdef DISPLAY_THREAD
+    if (render_thread)          /* render thread presents frames */
+        return;
+#endif
     ws_sync ();
 }
 
@@ -119,6 +119,24 @@ extern int display_point(int,int,int,int);
  */
 extern void display_line(int,int,int,int,int);
 
+/*
+ * plot a point as part of a run; same arguments (after the run) and
+ * result as display_point(), but drawing is deferred so that
+ * consecutive points advancing by the same step are drawn together.
+ * Pending points are drawn when the run is broken, or by
+ * display_run_flush(), which must be called before returning to the
+ * simulator.  A zeroed struct display_run is empty.
+ */
+struct display_run {
+    int x, y;                   /* first point (unscaled) */
+    int n;                      /* points so far */
+    int ix, iy;                 /* step between points */
+    int nx, ny;                 /* next point if the run continues */
+    int level, color;
+};
+extern int display_run_point(struct display_run *,int,int,int,int);
+extern void display_run_flush(struct display_run *);
+
 /*
  * force window system to output bits to screen;
  * call after adding points, or aging the screen
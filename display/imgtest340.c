@@ -0,0 +1,277 @@
+/*
+ * golden image test for type340.c and display.c:
+ * cc -o imgtest340 imgtest340.c imgws.c type340.c display.c -lm
+ *
+ * ./imgtest340 imgtest340.ok   compare, exit status 1 on any difference
+ * ./imgtest340 > imgtest340.ok make a new golden file
+ *
+ * Draws the display lists from tst340.c, vectors in every direction at
+ * every scale (clipped at the edges), continued and incremental vectors
+ * off the edge, display_line() vectors and munching squares (test.c)
+ * with the light pen held on the screen.  Light pen hits and edge flags
+ * go in the output along with the image.
+ */
+
+#include <stdio.h>
+
+#include "display.h"
+#include "ws.h"                         /* ws_lp_x, ws_lp_y */
+#include "type340.h"
+#include "type340cmd.h"
+
+extern int img_begin(const char *);
+extern void img_printf(const char *, ...);
+extern int img_end(void);
+
+#define LP_X    560                     /* on the star's right arm */
+#define LP_Y    512
+
+/* tst340.c: character test */
+static ty340word chars[] = {
+    MPT,                        /* param: point mode */
+    MPT|H|0,                    /* point: h=0; point mode */
+    MPAR|V|512,                 /* point: v=64; par mode */
+    MCHR|S3|IN7,                /* param: chr mode, size 3, intensity 7 */
+    CHAR('H'-'@', 'E'-'@', 'L'-'@'),
+    CHAR('L'-'@', 'O'-'@', ' '),
+    CHAR('W'-'@', 'O'-'@', 'R'-'@'),
+    CHAR('L'-'@', 'D'-'@', '!'),
+    CHAR(' ', 0, 037),
+    MCHR|S2|IN7,                /* param: chr mode, size 2, intensity 7 */
+    CHAR(CHRCR, CHRLF, 'H'-'@'),
+    CHAR('E'-'@', 'L'-'@', 'L'-'@'),
+    CHAR('O'-'@', ' ', 'W'-'@'),
+    CHAR('O'-'@', 'R'-'@', 'L'-'@'),
+    CHAR('D'-'@', '!', CHRESC),
+    MCHR|S1|IN7,                /* param: chr mode, size 1, intensity 7 */
+    CHAR(CHRCR, CHRLF, 'H'-'@'),
+    CHAR('E'-'@', 'L'-'@', 'L'-'@'),
+    CHAR('O'-'@', ' ', 'W'-'@'),
+    CHAR('O'-'@', 'R'-'@', 'L'-'@'),
+    CHAR('D'-'@', '!', CHRESC),
+
+    MCHR|S0|IN2,               /* param: chr mode, size 0, intensity 2 */
+    CHAR(CHRUC, CHRCR, CHRLF),
+    CHAR(000, 001, 002), CHAR(003, 004, 005), CHAR(006, 007, ' '),
+    CHAR(010, 011, 012), CHAR(013, 014, 015), CHAR(016, 017, ' '),
+    CHAR(020, 021, 022), CHAR(023, 024, 025), CHAR(026, 027, ' '),
+    CHAR(030, 031, 032),      /* 33-37 are control codes */
+    CHAR(040, 041, 042), CHAR(043, 044, 045), CHAR(046, 047, ' '),
+    CHAR(050, 051, 052), CHAR(053, 054, 055), CHAR(056, 057, ' '),
+    CHAR(060, 061, 062), CHAR(063, 064, 065), CHAR(066, 067, ' '),
+    CHAR(070, 071, 072), CHAR(073, 074, 075), CHAR(076, 077, ' '),
+
+    CHAR(CHRESC, CHRESC, CHRESC),
+    MCHR|S2|IN7,
+    CHAR(CHRLC, CHRCR, CHRLF),
+    CHAR(000, 001, 002), CHAR(003, 004, 005), CHAR(006, 007, ' '),
+    CHAR(010, 011, 012), CHAR(013, 014, 015), CHAR(016, 017, ' '),
+    CHAR(020, 021, 022), CHAR(023, 024, 025), CHAR(026, 027, ' '),
+    CHAR(030, 031, 032),
+    CHAR(CHRESC, 0, 0),
+    STP
+};
+
+/* tst340.c: H-340_Type_340_Precision_Incremental_CRT_System_Nov64.pdf */
+static ty340word curve[] = {
+    MPT|LPON|S2|IN3,            /* set params */
+    MPT|V|512,                  /* y axis */
+    MVCT|H|IP|512,              /* x axis, draw line */
+    ESCP|INSFY|DN|YP4|YP2|XP64, /* draw curve */
+    MINCR,                      /* set mode */
+    INSFY|INCRPT(PR,PR,PR,PR),  /* draw curve */
+    INSFY|INCRPT(PUR,PUR,PD,PD),
+    ESCP|INSFY|INCRPT(PD,PD,PDL,PDL),
+    MVCT,                       /* set mode */
+    ESCP|INSFY|LT|XP8,          /* draw line */
+    MINCR,                      /* set mode */
+    0237463,                    /* draw curve */
+    0231673,
+    0704210,
+    0100000,                    /* set mode */
+    0203400,                    /* draw line */
+    0600203,
+    0140000,                    /* set mode */
+    0377463,                    /* draw curve */
+    0631273,
+    0002000                     /* stop, set done, send data interrupt */
+};
+
+/* continued vector and incremental points run off the edges */
+static ty340word edges[] = {
+    MPT|LPON|S0|IN5,
+    MPT|H|900,
+    MPAR|V|100,
+    MVCTC|S1|IN5,               /* continue until an edge */
+    INSFY|DN|YP1|RT|XP4|XP1,
+    MPT,
+    MPT|H|6,
+    MPAR|V|1000,
+    MINCR|S0|IN6,
+    INSFY|INCRPT(PUL,PUL,PUL,PUL),
+    INSFY|INCRPT(PUL,PUL,PUL,PUL), /* escapes at the left edge */
+    STP
+};
+
+/* run a display list from the top, logging status changes */
+static void
+run(const char *name, ty340word *words, int n)
+{
+    ty340word last = 0;
+    int i;
+
+    img_printf("%s\n", name);
+    ty340_reset(NULL);
+    for (i = 0; i < n; i++) {
+        ty340word s = ty340_instruction(words[i]);
+
+        if ((s & ~ST340_STOPPED) != last)
+            img_printf("%d: status %o\n", i, s & ~ST340_STOPPED);
+        last = s & ~ST340_STOPPED;
+        if (s & ST340_STOPPED)
+            break;
+    }
+}
+
+/* vector mode word */
+static ty340word
+vec(int i, int dx, int dy)
+{
+    return (i ? INSFY : 0) |
+        (dy < 0 ? DN|(-dy << 8) : dy << 8) |
+        (dx < 0 ? LT|-dx : dx);
+}
+
+/* out and back from the middle, every octant and a few odd slopes */
+static void
+star(void)
+{
+    static const int dirs[][2] = {
+        { 127, 0 }, { 127, 127 }, { 0, 127 }, { -127, 127 },
+        { -127, 0 }, { -127, -127 }, { 0, -127 }, { 127, -127 },
+        { 120, 37 }, { 5, 111 }, { -100, 63 }, { -9, -1 },
+        { 17, -126 }, { 1, 1 }, { 3, 0 }, { 0, 0 }
+    };
+    ty340word words[4 + 2 * 16];
+    int n = 0, s, d;
+
+    for (s = 0; s < 4; s++) {
+        words[n++] = MPT;
+        words[n++] = MPT|H|512;
+        words[n++] = MPAR|V|512;
+        words[n++] = MVCT|LPON|(S0 + s * (S1 - S0))|(IN4 + s);
+        for (d = 0; d < 16; d++) {
+            words[n++] = vec(1, dirs[d][0], dirs[d][1]);
+            words[n++] = vec(0, -dirs[d][0], -dirs[d][1]);
+        }
+        words[n - 1] |= ESCP;
+        run("star", words, n);
+        n = 0;
+    }
+}
+
+/* test.c: munching squares */
+static void
+munch(unsigned long sw, int steps)
+{
+    long io = 0, v = 0, ac;
+    int x, y;
+
+    img_printf("munch %lo\n", sw);
+    while (steps-- > 0) {
+        ac = sw;
+        ac += v;                        /* add v */
+        if (ac & ~0777777) {
+            ac++;
+            ac &= 0777777;
+        }
+        v = ac;                         /* dac v */
+
+        ac <<= 9;                       /* rcl 9s */
+        io <<= 9;
+        io |= ac>>18;
+        ac &= 0777777;
+        ac |= io>>18;
+        io &= 0777777;
+
+        ac ^= v;                        /* xor v */
+
+        y = (io >> 8) & 01777;
+        if (y & 01000)
+            y ^= 01000;
+        else
+            y += 511;
+
+        x = (ac >> 8) & 01777;
+        if (x & 01000)
+            x ^= 01000;
+        else
+            x += 511;
+
+        if (display_point(x, y, DISPLAY_INT_MAX - 2, 0))
+            img_printf("lp %d %d\n", x, y);
+    }
+}
+
+/* display_line() in every direction */
+static void
+lines(void)
+{
+    int a;
+
+    img_printf("lines\n");
+    for (a = 0; a < 360; a += 15) {
+        int dx = (int)(200 * ((a % 90) - 45) / 45.0);
+        int x0 = 200, y0 = 800;
+
+        switch (a / 90) {
+        case 0: display_line(x0, y0, x0 + 200, y0 + dx, 5); break;
+        case 1: display_line(x0, y0, x0 - dx, y0 + 200, 6); break;
+        case 2: display_line(x0, y0, x0 - 200, y0 - dx, 7); break;
+        case 3: display_line(x0, y0, x0 + dx, y0 - 200, 4); break;
+        }
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    if (!img_begin(argc > 1 ? argv[1] : NULL))
+        return 1;
+    ws_lp_x = LP_X;
+    ws_lp_y = LP_Y;
+    run("chars", chars, sizeof(chars)/sizeof(chars[0]));
+    run("curve", curve, sizeof(curve)/sizeof(curve[0]));
+    run("edges", edges, sizeof(edges)/sizeof(edges[0]));
+    star();
+    lines();
+    munch(04000, 2000);
+    return img_end();
+}
+
+ty340word
+ty340_fetch(ty340word addr) {
+    return 0;
+}
+
+void
+ty340_store(ty340word addr, ty340word value) {
+}
+
+void
+ty340_lp_int(ty340word x, ty340word y) {
+    img_printf("lp %d %d\n", x, y);
+}
+
+void
+ty340_rfd(void) {                       /* request for data */
+}
+
+void
+cpu_get_switches(unsigned long *p1, unsigned long *p2) {
+    *p1 = *p2 = 0;
+}
+
+void
+cpu_set_switches(unsigned long sw1, unsigned long sw2) {
+}
@@ -0,0 +1,176 @@
+/*
+ * golden image test for vt11.c and display.c:
+ * cc -o imgtestvt imgtestvt.c imgws.c vt11.c display.c -lm
+ *
+ * ./imgtestvt imgtestvt.ok     compare, exit status 1 on any difference
+ * ./imgtestvt > imgtestvt.ok   make a new golden file
+ *
+ * Runs a display file taken from vttest.c (the line type box, normal
+ * and italic text, the light pen tracking object) plus relative points
+ * and graphplot, with the light pen held on the tracking object so
+ * hits intensify.  Light pen interrupts go in the output along with
+ * the image.
+ */
+
+#include <stdio.h>
+
+#include "ws.h"                         /* ws_lp_x, ws_lp_y */
+#include "display.h"
+#include "vt11.h"
+#include "vtmacs.h"
+
+extern int img_begin(const char *);
+extern void img_printf(const char *, ...);
+extern int img_end(void);
+
+#define LP_X    (01000 + 15)            /* on the tracking object */
+#define LP_Y    (01000 + 15)
+
+static unsigned short df[] = {
+    /* vttest.c: box just inside VR14 area using all four line types */
+    LSRA(ST_SAME, SI_SAME, LI_INTENSIFY, IT_NORMAL, RF_UNSYNC, MN_SAME),
+
+    SGM(GM_APOINT, IN_5, LP_ENA, BL_OFF, LT_SAME),
+    APOINT(I_OFF, 0, 0),
+
+    SGM(GM_LVECT, IN_SAME, LP_SAME, BL_SAME, LT_LDASH),
+    LVECT(I_ON, 01777, 0),
+
+    SGM(GM_LVECT, IN_SAME, LP_SAME, BL_SAME, LT_SDASH),
+    LVECT(I_ON, 0, 01377),
+
+    SGM(GM_LVECT, IN_SAME, LP_SAME, BL_SAME, LT_DDASH),
+    LVECT(I_ON, -01777, 0),
+
+    SGM(GM_LVECT, IN_SAME, LP_SAME, BL_SAME, LT_SOLID),
+    LVECT(I_ON, 0, -01377),
+
+    /* vttest.c: text, normal and italic */
+    SGM(GM_APOINT, IN_7, LP_ENA, BL_OFF, LT_SAME),
+    APOINT(I_OFF, 0, 736),
+
+    SGM(GM_CHAR, IN_SAME, LP_SAME, BL_SAME, LT_SOLID),
+    CHAR(' ',' '), CHAR('A','B'), CHAR('C','D'), CHAR('E','F'), CHAR('G','H'),
+    CHAR('I','J'), CHAR('K','L'), CHAR('M','N'), CHAR('O','P'), CHAR('Q','R'),
+    CHAR('S','T'), CHAR('U','V'), CHAR('W','X'), CHAR('Y','Z'), CHAR('\r','\n'),
+    CHAR(' ',' '), CHAR('a','b'), CHAR('c','d'), CHAR('e','f'), CHAR('g','h'),
+    CHAR('i','j'), CHAR('k','l'), CHAR('m','n'), CHAR('o','p'), CHAR('q','r'),
+    CHAR('s','t'), CHAR('u','v'), CHAR('w','x'), CHAR('y','z'), CHAR('\r','\n'),
+    CHAR(' ',' '), CHAR('0','1'), CHAR('2','3'), CHAR('4','5'), CHAR('6','7'),
+    CHAR('8','9'), CHAR(' ','!'), CHAR('"','#'), CHAR('$','%'), CHAR('&','\''),
+    CHAR('(',')'), CHAR('*','+'), CHAR(',','-'), CHAR('.','/'), CHAR('@',0),
+    CHAR('\r','\n'),
+
+    LSRA(ST_SAME, SI_SAME, LI_SAME, IT_ITALIC, RF_UNSYNC, MN_SAME),
+    CHAR(' ',' '), CHAR('A','B'), CHAR('C','D'), CHAR('E','F'), CHAR('G','H'),
+    CHAR('I','J'), CHAR('K','L'), CHAR('M','N'), CHAR('O','P'), CHAR('Q','R'),
+    CHAR('S','T'), CHAR('U','V'), CHAR('W','X'), CHAR('Y','Z'), CHAR('\r','\n'),
+    LSRA(ST_SAME, SI_SAME, LI_SAME, IT_NORMAL, RF_UNSYNC, MN_SAME),
+
+    /* relative points and graphplot, dimmer */
+    SGM(GM_APOINT, IN_3, LP_DIS, BL_SAME, LT_SAME),
+    APOINT(I_OFF, 100, 300),
+
+    SGM(GM_RPOINT, IN_SAME, LP_SAME, BL_SAME, LT_SAME),
+    RPOINT(I_ON, 2, 0), RPOINT(I_ON, 2, 0), RPOINT(I_ON, 2, 0),
+    RPOINT(I_ON, 0, 3), RPOINT(I_ON, 0, 3), RPOINT(I_ON, 0, 3),
+    RPOINT(I_ON, -5, -5), RPOINT(I_ON, 1, 1), RPOINT(I_ON, 1, 1),
+
+    SGM(GM_GRAPHX, IN_6, LP_SAME, BL_SAME, LT_SAME),
+    GRAPHX(I_ON, 200), GRAPHX(I_ON, 210), GRAPHX(I_ON, 220),
+    GRAPHX(I_ON, 230), GRAPHX(I_ON, 240), GRAPHX(I_ON, 250),
+
+    /* vttest.c: light pen tracking object, with the pen on it */
+    SGM(GM_APOINT, IN_SAME, LP_SAME, BL_SAME, LT_SAME),
+    APOINT(I_OFF, 01000, 01000),        /* screen center */
+
+    SGM(GM_SVECT, IN_7, LP_ENA, BL_SAME, LT_SOLID),
+    SVECT(I_OFF, 0, 30),
+    SVECT(I_ON, 0, -60),
+    SVECT(I_OFF, 30, 30),
+    SVECT(I_ON, -60, 0),
+    SVECT(I_ON, 30, 30),
+    SVECT(I_ON, 30, -30),
+    SVECT(I_ON, -30, -30),
+    SVECT(I_ON, -30, 30),
+    SVECT(I_OFF, 10, 0),
+    SVECT(I_ON, 20, 20),
+    SVECT(I_ON, 20, -20),
+    SVECT(I_ON, -20, -20),
+    SVECT(I_ON, -20, 20),
+
+    /* stop with interrupt */
+    LSRA(ST_STOP, SI_GENERATE, LI_SAME, IT_SAME, RF_UNSYNC, MN_SAME), 0
+};
+
+static int done;
+
+int
+main(int argc, char **argv)
+{
+    long n;
+
+    if (!img_begin(argc > 1 ? argv[1] : NULL))
+        return 1;
+    vt11_display = DIS_VR17;
+    vt11_scale = RES_FULL;
+    ws_lp_x = LP_X;
+    ws_lp_y = LP_Y;
+
+    vt11_reset(NULL, 0);
+    vt11_set_dpc(0);
+    for (n = 0; !done && n < 1000000; n++)
+        vt11_cycle(0, 0);               /* no time passes: no aging */
+    if (!done)
+        img_printf("did not stop\n");
+    return img_end();
+}
+
+/*
+ * callbacks from display.c
+ */
+void
+cpu_get_switches(unsigned long *p1, unsigned long *p2) {
+    *p1 = *p2 = 0;
+}
+
+void
+cpu_set_switches(unsigned long w1, unsigned long w2) {
+}
+
+/*
+ * callbacks from vt11.c
+ */
+
+int
+vt_fetch(uint32 addr, vt11word *w) {
+    if (addr/2 >= sizeof(df)/sizeof(df[0]))
+        return 1;
+    *w = df[addr/2];
+    return 0;
+}
+
+void
+vt_stop_intr(void) {
+    done = 1;
+}
+
+void
+vt_lpen_intr(void) {
+    img_printf("lp %o %o\n",
+               (unsigned)vt11_get_xpr() & 01777,
+               (unsigned)vt11_get_ypr() & 01777);
+    vt11_set_dpc((uint16)1);            /* resume */
+}
+
+void
+vt_char_intr(void) {
+    img_printf("char intr\n");
+    vt11_set_dpc((uint16)1);            /* resume */
+}
+
+void
+vt_name_intr(void) {
+    img_printf("name intr\n");
+    vt11_set_dpc((uint16)1);            /* resume */
+}
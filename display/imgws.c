@@ -0,0 +1,208 @@
+/*
+ * In-memory "window system" for the golden image tests
+ * (imgtest340.c, imgtestvt.c): points land in a pixel array that is
+ * written out as text, one line per horizontal run of one color, and
+ * compared with a golden file.  No display or event handling at all.
+ *
+ * img_begin(golden) before drawing: with a golden file name the image
+ * is compared with it, with NULL it is written to stdout (to make a new
+ * golden file).  img_printf() adds lines (light pen hits, status) to
+ * the output ahead of the image; img_end() returns the exit status.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "ws.h"
+#include "display.h"
+
+int ws_lp_x = -1;
+int ws_lp_y = -1;
+
+struct color {
+    int r, g, b;                /* 16 bits each */
+};
+
+static struct color black = { 0, 0, 0 };
+static struct color white = { 0xffff, 0xffff, 0xffff };
+
+static struct color **pixels;   /* (0,0) is lower left */
+static int xpixels, ypixels;
+
+static FILE *out;               /* log and image */
+static const char *golden;      /* compare with, or NULL */
+
+int
+ws_init(const char *crtname,    /* crt type name */
+        int xp, int yp,         /* screen size in pixels */
+        int colors,             /* colors to support (not used) */
+        void *dptr)
+{
+    int i;
+
+    xpixels = xp;
+    ypixels = yp;
+    pixels = (struct color **)malloc(xp * yp * sizeof(*pixels));
+    if (!pixels)
+        return 0;
+    for (i = 0; i < xp * yp; i++)
+        pixels[i] = &black;
+    return 1;
+}
+
+void ws_shutdown (void)
+{
+}
+
+void *
+ws_color_black(void)
+{
+    return &black;
+}
+
+void *
+ws_color_white(void)
+{
+    return &white;
+}
+
+void *
+ws_color_rgb(int r, int g, int b)
+{
+    struct color *c = (struct color *)malloc(sizeof(*c));
+
+    if (c) {
+        c->r = r;
+        c->g = g;
+        c->b = b;
+    }
+    return c;
+}
+
+void
+ws_display_point(int x, int y, void *color)
+{
+    if (x < 0 || x >= xpixels || y < 0 || y >= ypixels)
+        return;
+    pixels[y * xpixels + x] = color ? (struct color *)color : &black;
+}
+
+void
+ws_sync(void)
+{
+}
+
+int
+ws_poll(int *valp, int maxusec)
+{
+    return 1;
+}
+
+void
+ws_beep(void)
+{
+}
+
+/* no real time: display_delay() never sleeps */
+unsigned long
+os_elapsed(void)
+{
+    return ~0L;
+}
+
+int
+img_begin(const char *file)
+{
+    golden = file;
+    out = golden ? tmpfile() : stdout;
+    return out != NULL;
+}
+
+void
+img_printf(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    vfprintf(out, fmt, ap);
+    va_end(ap);
+}
+
+/*
+ * write the lit rows, top first, as "y: x[+n]=rrggbb ..."
+ * for each run of n pixels (n>1) of one color starting at x
+ */
+static void
+img_write(void)
+{
+    int x, y, n;
+
+    fprintf(out, "image %d %d\n", xpixels, ypixels);
+    for (y = ypixels - 1; y >= 0; y--) {
+        struct color **row = pixels + y * xpixels;
+        int lit = 0;
+
+        for (x = 0; x < xpixels; x += n) {
+            struct color *c = row[x];
+
+            for (n = 1; x + n < xpixels && row[x + n] == c; n++)
+                ;
+            if (!(c->r | c->g | c->b))
+                continue;
+            if (!lit++)
+                fprintf(out, "%d:", y);
+            if (n > 1)
+                fprintf(out, " %d+%d", x, n);
+            else
+                fprintf(out, " %d", x);
+            fprintf(out, "=%02x%02x%02x", c->r >> 8, c->g >> 8, c->b >> 8);
+        }
+        if (lit)
+            fprintf(out, "\n");
+    }
+}
+
+int
+img_end(void)
+{
+    static char want[16384], got[16384];   /* a row of single pixels */
+    FILE *f;
+    int line;
+
+    if (!pixels) {
+        fprintf(stderr, "display never initialized\n");
+        return 1;
+    }
+    img_write();
+    if (!golden)
+        return 0;
+
+    f = fopen(golden, "r");
+    if (!f) {
+        perror(golden);
+        return 1;
+    }
+    rewind(out);
+    for (line = 1; ; line++) {
+        char *w = fgets(want, sizeof(want), f);
+        char *g = fgets(got, sizeof(got), out);
+        char *cr = w ? strchr(w, '\r') : NULL;
+
+        if (cr)                         /* golden file has DOS line ends */
+            strcpy(cr, "\n");
+        if (!w && !g)
+            break;
+        if (!w || !g || strcmp(w, g) != 0) {
+            printf("%s:%d: differs\n", golden, line);
+            printf("  want: %s", w ? w : "EOF\n");
+            printf("  got:  %s", g ? g : "EOF\n");
+            fclose(f);
+            return 1;
+        }
+    }
+    fclose(f);
+    printf("%s: ok\n", golden);
+    return 0;
+}
@@ -134,6 +134,9 @@ static struct type340 {
     ty340word ASR;              /* Address Save Register */
     unsigned char SAVE_FF;      /* "save" flip-flop */
 #endif
+#ifndef TY340_NODISPLAY
+    struct display_run run[2];  /* points not yet drawn; see point() */
+#endif
 } u340[TY340_UNITS];
 
 #if TY340_UNITS == 1
@@ -223,8 +226,13 @@ ty340_reset(void *dptr)
     return u->status;
 }
 
+/*
+ * points are drawn through display runs, flushed at the end of each
+ * instruction; lineTwoStep() draws from both ends at once, so the far
+ * end gets a run of its own.
+ */
 static int
-point(int x, int y, int seq)
+point(int r, int x, int y, int seq)
 {
     struct type340 *u = UNIT(0);
     int i;
@@ -249,7 +257,7 @@ point(int x, int y, int seq)
     }
 
 #ifndef TY340_NODISPLAY
-    if (display_point(x, y, i, 0)) {
+    if (display_run_point(&u->run[r], x, y, i, 0)) {
         /*
          * in real life: type340 pauses
          * until CPU reads coordinates
@@ -263,12 +271,24 @@ point(int x, int y, int seq)
 }
 
 void
-lpoint(int x, int y)
+lpoint(int r, int x, int y)
 {
 #ifdef TYPE340_LPOINT
     DEBUGF(("type340 lpoint %d %d\r\n", x, y));
 #endif
-    point(x, y, 0);
+    point(r, x, y, 0);
+}
+
+/* draw the points still held in the runs */
+static void
+flush(void)
+{
+#ifndef TY340_NODISPLAY
+    struct type340 *u = UNIT(0);
+
+    display_run_flush(&u->run[0]);
+    display_run_flush(&u->run[1]);
+#endif
 }
 
 /*
@@ -296,10 +316,10 @@ lineTwoStep(int x0, int y0, int x1, int y1)
     if (dy < 0) { dy = -dy;  stepy = -1; } else { stepy = 1; }
     if (dx < 0) { dx = -dx;  stepx = -1; } else { stepx = 1; }
 
-    lpoint(x0,y0);
+    lpoint(0, x0,y0);
     if (dx == 0 && dy == 0)             /* following algorithm won't work */
         return;                         /* just the one dot */
-    lpoint(x1, y1);
+    lpoint(1, x1, y1);
     if (dx > dy) {
         int length = (dx - 1) >> 2;
         int extras = (dx - 1) & 3;
@@ -314,41 +334,41 @@ lineTwoStep(int x0, int y0, int x1, int y1)
                 x0 += stepx;
                 x1 -= stepx;
                 if (d < 0) {                            /* Pattern: */
-                    lpoint(x0, y0);
-                    lpoint(x0 += stepx, y0);            /*  x o o   */
-                    lpoint(x1, y1);
-                    lpoint(x1 -= stepx, y1);
+                    lpoint(0, x0, y0);
+                    lpoint(0, x0 += stepx, y0);         /*  x o o   */
+                    lpoint(1, x1, y1);
+                    lpoint(1, x1 -= stepx, y1);
                     d += incr1;
                 }
                 else {
-                    if (d < c) {                          /* Pattern: */
-                        lpoint(x0, y0);                   /*      o   */
-                        lpoint(x0 += stepx, y0 += stepy); /*  x o     */
-                        lpoint(x1, y1);
-                        lpoint(x1 -= stepx, y1 -= stepy);
+                    if (d < c) {                             /* Pattern: */
+                        lpoint(0, x0, y0);                   /*      o   */
+                        lpoint(0, x0 += stepx, y0 += stepy); /*  x o     */
+                        lpoint(1, x1, y1);
+                        lpoint(1, x1 -= stepx, y1 -= stepy);
                     } else {
-                        lpoint(x0, y0 += stepy);        /* Pattern: */
-                        lpoint(x0 += stepx, y0);        /*    o o   */
-                        lpoint(x1, y1 -= stepy);        /*  x       */
-                        lpoint(x1 -= stepx, y1);
+                        lpoint(0, x0, y0 += stepy);     /* Pattern: */
+                        lpoint(0, x0 += stepx, y0);     /*    o o   */
+                        lpoint(1, x1, y1 -= stepy);     /*  x       */
+                        lpoint(1, x1 -= stepx, y1);
                     }
                     d += incr2;
                 }
             }
             if (extras > 0) {
                 if (d < 0) {
-                    lpoint(x0 += stepx, y0);
-                    if (extras > 1) lpoint(x0 += stepx, y0);
-                    if (extras > 2) lpoint(x1 -= stepx, y1);
+                    lpoint(0, x0 += stepx, y0);
+                    if (extras > 1) lpoint(0, x0 += stepx, y0);
+                    if (extras > 2) lpoint(1, x1 -= stepx, y1);
                 } else
                     if (d < c) {
-                        lpoint(x0 += stepx, y0);
-                        if (extras > 1) lpoint(x0 += stepx, y0 += stepy);
-                        if (extras > 2) lpoint(x1 -= stepx, y1);
+                        lpoint(0, x0 += stepx, y0);
+                        if (extras > 1) lpoint(0, x0 += stepx, y0 += stepy);
+                        if (extras > 2) lpoint(1, x1 -= stepx, y1);
                     } else {
-                        lpoint(x0 += stepx, y0 += stepy);
-                        if (extras > 1) lpoint(x0 += stepx, y0);
-                        if (extras > 2) lpoint(x1 -= stepx, y1 -= stepy);
+                        lpoint(0, x0 += stepx, y0 += stepy);
+                        if (extras > 1) lpoint(0, x0 += stepx, y0);
+                        if (extras > 2) lpoint(1, x1 -= stepx, y1 -= stepy);
                     }
             }
         } else {
@@ -360,43 +380,43 @@ lineTwoStep(int x0, int y0, int x1, int y1)
                 x0 += stepx;
                 x1 -= stepx;
                 if (d > 0) {
-                    lpoint(x0, y0 += stepy);            /* Pattern: */
-                    lpoint(x0 += stepx, y0 += stepy);   /*      o   */
-                    lpoint(x1, y1 -= stepy);            /*    o     */
-                    lpoint(x1 -= stepx, y1 -= stepy);   /*  x       */
+                    lpoint(0, x0, y0 += stepy);            /* Pattern: */
+                    lpoint(0, x0 += stepx, y0 += stepy);   /*      o   */
+                    lpoint(1, x1, y1 -= stepy);            /*    o     */
+                    lpoint(1, x1 -= stepx, y1 -= stepy);   /*  x       */
                     d += incr1;
                 } else {
                     if (d < c) {
-                        lpoint(x0, y0);                   /* Pattern: */
-                        lpoint(x0 += stepx, y0 += stepy); /*      o   */
-                        lpoint(x1, y1);                   /*  x o     */
-                        lpoint(x1 -= stepx, y1 -= stepy);
+                        lpoint(0, x0, y0);                   /* Pattern: */
+                        lpoint(0, x0 += stepx, y0 += stepy); /*      o   */
+                        lpoint(1, x1, y1);                   /*  x o     */
+                        lpoint(1, x1 -= stepx, y1 -= stepy);
                     } else {
-                        lpoint(x0, y0 += stepy);        /* Pattern: */
-                        lpoint(x0 += stepx, y0);        /*    o o   */
-                        lpoint(x1, y1 -= stepy);        /*  x       */
-                        lpoint(x1 -= stepx, y1);
+                        lpoint(0, x0, y0 += stepy);     /* Pattern: */
+                        lpoint(0, x0 += stepx, y0);     /*    o o   */
+                        lpoint(1, x1, y1 -= stepy);     /*  x       */
+                        lpoint(1, x1 -= stepx, y1);
                     }
                     d += incr2;
                 }
             }
             if (extras > 0) {
                 if (d > 0) {
-                    lpoint(x0 += stepx, y0 += stepy);
-                    if (extras > 1) lpoint(x0 += stepx, y0 += stepy);
-                    if (extras > 2) lpoint(x1 -= stepx, y1 -= stepy);
+                    lpoint(0, x0 += stepx, y0 += stepy);
+                    if (extras > 1) lpoint(0, x0 += stepx, y0 += stepy);
+                    if (extras > 2) lpoint(1, x1 -= stepx, y1 -= stepy);
                 } else if (d < c) {
-                    lpoint(x0 += stepx, y0);
-                    if (extras > 1) lpoint(x0 += stepx, y0 += stepy);
-                    if (extras > 2) lpoint(x1 -= stepx, y1);
+                    lpoint(0, x0 += stepx, y0);
+                    if (extras > 1) lpoint(0, x0 += stepx, y0 += stepy);
+                    if (extras > 2) lpoint(1, x1 -= stepx, y1);
                 } else {
-                    lpoint(x0 += stepx, y0 += stepy);
-                    if (extras > 1) lpoint(x0 += stepx, y0);
+                    lpoint(0, x0 += stepx, y0 += stepy);
+                    if (extras > 1) lpoint(0, x0 += stepx, y0);
                     if (extras > 2) {
                         if (d > c)
-                            lpoint(x1 -= stepx, y1 -= stepy);
+                            lpoint(1, x1 -= stepx, y1 -= stepy);
                         else
-                            lpoint(x1 -= stepx, y1);
+                            lpoint(1, x1 -= stepx, y1);
                     }
                 }
             }
@@ -414,40 +434,40 @@ lineTwoStep(int x0, int y0, int x1, int y1)
                 y0 += stepy;
                 y1 -= stepy;
                 if (d < 0) {
-                    lpoint(x0, y0);
-                    lpoint(x0, y0 += stepy);
-                    lpoint(x1, y1);
-                    lpoint(x1, y1 -= stepy);
+                    lpoint(0, x0, y0);
+                    lpoint(0, x0, y0 += stepy);
+                    lpoint(1, x1, y1);
+                    lpoint(1, x1, y1 -= stepy);
                     d += incr1;
                 } else {
                     if (d < c) {
-                        lpoint(x0, y0);
-                        lpoint(x0 += stepx, y0 += stepy);
-                        lpoint(x1, y1);
-                        lpoint(x1 -= stepx, y1 -= stepy);
+                        lpoint(0, x0, y0);
+                        lpoint(0, x0 += stepx, y0 += stepy);
+                        lpoint(1, x1, y1);
+                        lpoint(1, x1 -= stepx, y1 -= stepy);
                     } else {
-                        lpoint(x0 += stepx, y0);
-                        lpoint(x0, y0 += stepy);
-                        lpoint(x1 -= stepx, y1);
-                        lpoint(x1, y1 -= stepy);
+                        lpoint(0, x0 += stepx, y0);
+                        lpoint(0, x0, y0 += stepy);
+                        lpoint(1, x1 -= stepx, y1);
+                        lpoint(1, x1, y1 -= stepy);
                     }
                     d += incr2;
                 }
             }
             if (extras > 0) {
                 if (d < 0) {
-                    lpoint(x0, y0 += stepy);
-                    if (extras > 1) lpoint(x0, y0 += stepy);
-                    if (extras > 2) lpoint(x1, y1 -= stepy);
+                    lpoint(0, x0, y0 += stepy);
+                    if (extras > 1) lpoint(0, x0, y0 += stepy);
+                    if (extras > 2) lpoint(1, x1, y1 -= stepy);
                 } else
                     if (d < c) {
-                        lpoint(x0, y0 += stepy);
-                        if (extras > 1) lpoint(x0 += stepx, y0 += stepy);
-                        if (extras > 2) lpoint(x1, y1 -= stepy);
+                        lpoint(0, x0, y0 += stepy);
+                        if (extras > 1) lpoint(0, x0 += stepx, y0 += stepy);
+                        if (extras > 2) lpoint(1, x1, y1 -= stepy);
                     } else {
-                        lpoint(x0 += stepx, y0 += stepy);
-                        if (extras > 1) lpoint(x0, y0 += stepy);
-                        if (extras > 2) lpoint(x1 -= stepx, y1 -= stepy);
+                        lpoint(0, x0 += stepx, y0 += stepy);
+                        if (extras > 1) lpoint(0, x0, y0 += stepy);
+                        if (extras > 2) lpoint(1, x1 -= stepx, y1 -= stepy);
                     }
             }
         } else {
@@ -459,43 +479,43 @@ lineTwoStep(int x0, int y0, int x1, int y1)
                 y0 += stepy;
                 y1 -= stepy;
                 if (d > 0) {
-                    lpoint(x0 += stepx, y0);
-                    lpoint(x0 += stepx, y0 += stepy);
-                    lpoint(x1 -= stepx, y1);
-                    lpoint(x1 -= stepx, y1 -= stepy);
+                    lpoint(0, x0 += stepx, y0);
+                    lpoint(0, x0 += stepx, y0 += stepy);
+                    lpoint(1, x1 -= stepx, y1);
+                    lpoint(1, x1 -= stepx, y1 -= stepy);
                     d += incr1;
                 } else {
                     if (d < c) {
-                        lpoint(x0, y0);
-                        lpoint(x0 += stepx, y0 += stepy);
-                        lpoint(x1, y1);
-                        lpoint(x1 -= stepx, y1 -= stepy);
+                        lpoint(0, x0, y0);
+                        lpoint(0, x0 += stepx, y0 += stepy);
+                        lpoint(1, x1, y1);
+                        lpoint(1, x1 -= stepx, y1 -= stepy);
                     } else {
-                        lpoint(x0 += stepx, y0);
-                        lpoint(x0, y0 += stepy);
-                        lpoint(x1 -= stepx, y1);
-                        lpoint(x1, y1 -= stepy);
+                        lpoint(0, x0 += stepx, y0);
+                        lpoint(0, x0, y0 += stepy);
+                        lpoint(1, x1 -= stepx, y1);
+                        lpoint(1, x1, y1 -= stepy);
                     }
                     d += incr2;
                 }
             }
             if (extras > 0) {
                 if (d > 0) {
-                    lpoint(x0 += stepx, y0 += stepy);
-                    if (extras > 1) lpoint(x0 += stepx, y0 += stepy);
-                    if (extras > 2) lpoint(x1 -= stepx, y1 -= stepy);
+                    lpoint(0, x0 += stepx, y0 += stepy);
+                    if (extras > 1) lpoint(0, x0 += stepx, y0 += stepy);
+                    if (extras > 2) lpoint(1, x1 -= stepx, y1 -= stepy);
                 } else if (d < c) {
-                    lpoint(x0, y0 += stepy);
-                    if (extras > 1) lpoint(x0 += stepx, y0 += stepy);
-                    if (extras > 2) lpoint(x1, y1 -= stepy);
+                    lpoint(0, x0, y0 += stepy);
+                    if (extras > 1) lpoint(0, x0 += stepx, y0 += stepy);
+                    if (extras > 2) lpoint(1, x1, y1 -= stepy);
                 } else {
-                    lpoint(x0 += stepx, y0 += stepy);
-                    if (extras > 1) lpoint(x0, y0 += stepy);
+                    lpoint(0, x0 += stepx, y0 += stepy);
+                    if (extras > 1) lpoint(0, x0, y0 += stepy);
                     if (extras > 2) {
                         if (d > c)
-                            lpoint(x1 -= stepx, y1 -= stepy);
+                            lpoint(1, x1 -= stepx, y1 -= stepy);
                         else
-                            lpoint(x1, y1 -= stepy);
+                            lpoint(1, x1, y1 -= stepy);
                     }
                 }
             }
@@ -607,7 +627,7 @@ ipoint(int i, int n, unsigned char byte)
         }
     }
     if (i)
-        point(u->xpos, u->ypos, n);
+        point(0, u->xpos, u->ypos, n);
 
     return 0;                           /* no escape */
 }
@@ -825,7 +845,7 @@ character(int n, unsigned char c)
         for (y = 0; y < 7; y++) {       /* row: 0 to 6, bottom to top */
             if (chars[c][x] & (2<<y)) {
                 /* XXX check for raster violation? */
-                point(u->xpos+x*s, u->ypos+y*s, n);
+                point(0, u->xpos+x*s, u->ypos+y*s, n);
             }
         }
     }
@@ -919,7 +939,7 @@ ty340_instruction(ty340word inst)
         }
         if (TESTBIT(inst, 7)) {         /* intensify */
             DEBUGF(("type340 point (%d,%d)\r\n", u->ypos, u->xpos));
-            point(u->xpos, u->ypos, 0);
+            point(0, u->xpos, u->ypos, 0);
         }
         break;
 
@@ -1008,6 +1028,7 @@ ty340_instruction(ty340word inst)
 #endif
         break;
     }
+    flush();
 
     if (escape) {
         u->mode = PARAM;
@@ -1178,7 +1178,12 @@ dintens(int32 z)
  * necessary.
  */
 
-/* illuminate pixel in raster image */
+/*
+ * illuminate pixel in raster image
+ * points are drawn through vt_run, flushed before the display is aged
+ */
+
+static struct display_run vt_run;
 
 static void
 illum3(int32 x, int32 y, int32 z)
@@ -1197,7 +1202,7 @@ illum3(int32 x, int32 y, int32 z)
 
     i = dintens(z);
 
-    if (display_point((int)x, (int)y, i, 0)    /* XXX VS60 might switch color */
+    if (display_run_point(&vt_run, (int)x, (int)y, i, 0) /* XXX VS60 color? */
         /* VT11, per maintenance spec, has threshold 6 for CHAR, 4 for others */
         /* but the classic Lunar Lander uses 3 for its menu and thrust bar! */
         /* I seem to recall that both thresholds were 4 for the VS60 (VR48). */
@@ -1222,8 +1227,10 @@ illum3(int32 x, int32 y, int32 z)
             lp_xpos -= MENU_OFFSET;
         lp_ypos = y;
         lp_zpos = z;
-        if (lp_intensify)               /* [technically shouldn't exceed max] */
+        if (lp_intensify) {             /* [technically shouldn't exceed max] */
+            display_run_flush(&vt_run); /* draw over the point just plotted */
             display_point((int)x, (int)y, DISPLAY_INT_MAX, 0);
+        }
                 /* XXX  appropriate for VT11; what about VS60?  chars? */
     }
 }
@@ -3838,6 +3845,7 @@ vt11_cycle(int us, int slowdown)
     /* fall through to age_ret */
 
   age_ret:
+    display_run_flush(&vt_run);
     display_age(us, slowdown);
     return !maint1 && !maint2 && busy;
 } /* vt11_cycle */
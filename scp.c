@@ -1200,6 +1200,17 @@ static const char simh_help1[] =
       "5-q\n"
       " If the -q switch is specified when creating a new file (-n) or opening one\n"
       " read only (-r), any messages announcing these facts will be suppressed.\n"
+      "5-o\n"
+      " If the -o switch is specified with two file names, the first is used as a\n"
+      " read only base image and all writes go to the second, a sparse delta file\n"
+      " which is created if it does not exist:\n\n"
+      "++ATTACH -o <unit> <base_file> <delta_file>\n\n"
+      " Blocks which have not been written are read from the base file, so many\n"
+      " simulators can share one base.  The base must not change while any delta\n"
+      " made from it is in use.  SAVE records that the unit is an overlay, so\n"
+      " RESTORE attaches it to the same base and delta.  With -r, or on a unit\n"
+      " which is read only, the overlay is read only: an existing delta is read\n"
+      " but nothing is written to it.\n"
       "5-f\n"
       " For simulated magnetic tapes, the ATTACH command can specify the format of\n"
       " the attached tape image file:\n\n"
@@ -8211,12 +8222,30 @@ if (dptr->attach != NULL)                               /* device routine? */
 return attach_unit (uptr, (CONST char *)cptr);          /* no, std routine */
 }
 
-/* Attach unit to file */
+/* Attach unit to file
+
+   attach_unit_setvbuf gives the stream the caller's stdio buffer right
+   after it is opened, before anything reads or seeks it.
+*/
+
+static t_stat _attach_unit (UNIT *uptr, CONST char *cptr, char *vbuf, size_t vbufsize);
 
 t_stat attach_unit (UNIT *uptr, CONST char *cptr)
 {
+return _attach_unit (uptr, cptr, NULL, 0);
+}
+
+t_stat attach_unit_setvbuf (UNIT *uptr, CONST char *cptr, char *vbuf, size_t vbufsize)
+{
+return _attach_unit (uptr, cptr, vbuf, vbufsize);
+}
+
+static t_stat _attach_unit (UNIT *uptr, CONST char *cptr, char *vbuf, size_t vbufsize)
+{
 DEVICE *dptr;
 t_bool open_rw = FALSE;
+char base[CBUFSIZE], delta[CBUFSIZE];
+CONST char *tptr;
 
 if (!(uptr->flags & UNIT_ATTABLE))                      /* not attachable? */
     return SCPE_NOATT;
@@ -8226,7 +8255,46 @@ uptr->filename = (char *) calloc (CBUFSIZE, sizeof (char)); /* alloc name buf */
 if (uptr->filename == NULL)
     return SCPE_MEM;
 strlcpy (uptr->filename, cptr, CBUFSIZE);               /* save name */
-if ((sim_switches & SWMASK ('R')) ||                    /* read only? */
+*delta = '\0';
+if (sim_switches & SWMASK ('O')) {                      /* overlay? */
+    tptr = get_glyph_quoted (cptr, base, 0);            /* base and delta */
+    tptr = get_glyph_quoted (tptr, delta, 0);
+    if (*tptr != '\0')                                  /* must be just two */
+        *delta = '\0';
+    }
+if (*delta != '\0') {                                   /* copy-on-write overlay */
+    t_bool rdonly = ((sim_switches & SWMASK ('R')) ||   /* read only? */
+                     ((uptr->flags & UNIT_RO) != 0));
+
+    if (rdonly &&
+        ((uptr->flags & UNIT_ROABLE) == 0) &&           /* allowed? */
+        ((uptr->flags & UNIT_RO) == 0))
+        return sim_messagef (attach_err (uptr, SCPE_NORO), "%s: Read Only operation not allowed\n", /* no, error */
+                                                        sim_uname (uptr));
+    uptr->fileref = sim_fopen_overlay (base, delta, rdonly ? "rb" : "rb+");
+#if defined(EPERM)
+    if ((uptr->fileref == NULL) && !rdonly &&           /* delta read only? */
+        ((errno == EROFS) || (errno == EACCES) || (errno == EPERM))) {
+#else
+    if ((uptr->fileref == NULL) && !rdonly &&           /* delta read only? */
+        ((errno == EROFS) || (errno == EACCES))) {
+#endif
+        if ((uptr->flags & UNIT_ROABLE) == 0)           /* allowed? */
+            return sim_messagef (attach_err (uptr, SCPE_NORO), "%s: Read Only operation not allowed\n", /* no, error */
+                                                            sim_uname (uptr));
+        rdonly = TRUE;
+        uptr->fileref = sim_fopen_overlay (base, delta, "rb");
+        }
+    if (uptr->fileref == NULL)                          /* open fail? */
+        return sim_messagef (attach_err (uptr, SCPE_OPENERR), "%s: Can't open overlay '%s' of '%s': %s\n", /* yes, error */
+                                            sim_uname (uptr), delta, base, strerror (errno));
+    if (rdonly) {
+        if (!(uptr->flags & UNIT_RO))
+            sim_messagef (SCPE_OK, "%s: unit is read only\n", sim_uname (uptr));
+        uptr->flags = uptr->flags | UNIT_RO;            /* set rd only */
+        }
+    }
+else if ((sim_switches & SWMASK ('R')) ||               /* read only? */
     ((uptr->flags & UNIT_RO) != 0)) {
     if (((uptr->flags & UNIT_ROABLE) == 0) &&           /* allowed? */
         ((uptr->flags & UNIT_RO) == 0))
@@ -8281,6 +8349,9 @@ else {
             open_rw = TRUE;
         }                                               /* end else */
     }
+if ((vbuf != NULL) &&                                   /* caller's stdio buffer? */
+    ((uptr->flags & UNIT_BUFABLE) == 0))
+    setvbuf (uptr->fileref, vbuf, _IOFBF, vbufsize);
 if (uptr->flags & UNIT_BUFABLE) {                       /* buffer? */
     uint32 cap = ((uint32) uptr->capac) / dptr->aincr;  /* effective size */
 
@@ -8304,6 +8375,8 @@ if (uptr->flags & UNIT_BUFABLE) {                       /* buffer? */
     uptr->flags = uptr->flags | UNIT_BUF;               /* set buffered */
     }
 uptr->flags = uptr->flags | UNIT_ATT;
+if (*delta != '\0')                                     /* overlay? */
+    uptr->dynflags |= UNIT_OVERLAY;                     /* so SAVE records it */
 uptr->pos = 0;
 if (open_rw &&                                      /* open for write in append mode? */
     (sim_switches & SWMASK ('A')) &&
@@ -8436,6 +8509,7 @@ if ((uptr->flags & UNIT_BUF) && (uptr->filebuf)) {
     uptr->flags = uptr->flags & ~UNIT_BUF;
     }
 uptr->flags = uptr->flags & ~(UNIT_ATT | ((uptr->flags & UNIT_ROABLE) ? UNIT_RO : 0));
+uptr->dynflags = uptr->dynflags & ~UNIT_OVERLAY;
 free (uptr->filename);
 uptr->filename = NULL;
 if (uptr->fileref) {                        /* Only close open file */
@@ -8753,7 +8827,7 @@ int32 *attswitches = NULL;
 int32 attcnt = 0;
 void *mbuf = NULL;
 int32 j, blkcnt, limit, unitno, time, flg;
-uint32 us, depth;
+uint32 us, depth, dflg;
 t_addr k, high, old_capac;
 t_value val, max;
 t_stat r;
@@ -8902,8 +8976,10 @@ for ( ;; ) {                                            /* device loop */
         READ_I (uptr->u5);                              /* [V3.0+] more dev spec */
         READ_I (uptr->u6);
         READ_I (flg);                                   /* [V2.10+] unit flags */
+        dflg = 0;
         if (v40) {                                      /* [V4.0+] dynflags */
-            READ_I (uptr->dynflags);
+            READ_I (dflg);                              /* overlay bit follows attach */
+            uptr->dynflags = (dflg & ~UNIT_OVERLAY) | (uptr->dynflags & UNIT_OVERLAY);
             READ_I (uptr->wait);
             READ_I (uptr->buf);
             READ_I (uptr->recsize);
@@ -8939,6 +9015,8 @@ for ( ;; ) {                                            /* device loop */
             uptr->flags = uptr->flags & ~UNIT_DIS;      /* ensure device is enabled */
             if (flg & UNIT_RO)                          /* [V2.10+] saved flgs & RO? */
                 sim_switches |= SWMASK ('R');           /* RO attach */
+            if (dflg & UNIT_OVERLAY)                    /* saved as overlay? */
+                sim_switches |= SWMASK ('O');           /* base and delta */
             /* add unit to list of units to attach after registers are read */
             attunits = (UNIT **)realloc (attunits, sizeof (*attunits)*(attcnt+1));
             attunits[attcnt] = uptr;
@@ -16504,6 +16582,148 @@ sim_set_deb_switches (start_deb_switches);
 return r;
 }
 
+/* Copy-on-write overlay attach: writes go to the delta and leave the
+   base alone, read only attaches follow -R and UNIT_ROABLE, and an
+   overlay unit comes back with its delta after SAVE and RESTORE */
+
+#define OVL_TEST_BASE   "overlay_test.base"
+#define OVL_TEST_DELTA  "overlay_test.delta"
+#define OVL_TEST_SIZE   (3 * 4096)
+#define OVL_TEST_POS    5000
+
+static t_stat test_scp_overlay_check (UNIT *uptr, const char *what, const char *expect)
+{
+char buf[32];
+
+memset (buf, 0, sizeof (buf));
+if ((sim_fseek (uptr->fileref, OVL_TEST_POS, SEEK_SET) != 0) ||
+    (sim_fread (buf, 1, strlen (expect), uptr->fileref) != strlen (expect)) ||
+    (memcmp (buf, expect, strlen (expect)) != 0))
+    return sim_messagef (SCPE_IERR, "overlay %s: read '%s', expected '%s'\n", what, buf, expect);
+return SCPE_OK;
+}
+
+static t_stat test_scp_overlay (void)
+{
+DEVICE *dptr = &sim_scp_dev;
+UNIT *uptr = &dptr->units[0];
+uint32 saved_dflags = dptr->flags;
+uint32 saved_uflags = uptr->flags;
+int32 saved_switches = sim_switches;
+char base[OVL_TEST_SIZE], check[OVL_TEST_SIZE];
+const char *files = OVL_TEST_BASE " " OVL_TEST_DELTA;
+FILE *f, *save;
+int i;
+t_stat r;
+
+sim_printf ("\n*** Copy-on-write overlay attach tests\n");
+for (i = 0; i < OVL_TEST_SIZE; i++)
+    base[i] = 'a' + (i % 26);
+(void)remove (OVL_TEST_DELTA);
+f = sim_fopen (OVL_TEST_BASE, "wb");
+if ((f == NULL) || (sim_fwrite (base, 1, sizeof (base), f) != sizeof (base)))
+    return sim_messagef (SCPE_IERR, "Can't create %s\n", OVL_TEST_BASE);
+fclose (f);
+f = sim_fopen_overlay (OVL_TEST_BASE, OVL_TEST_DELTA, "rb");
+if ((f == NULL) && (errno == ENOSYS)) {
+    (void)remove (OVL_TEST_BASE);
+    sim_printf ("Overlays are not supported on this host\n");
+    return SCPE_OK;
+    }
+if (f != NULL)
+    fclose (f);
+r = SCPE_IERR;
+dptr->flags &= ~DEV_NOSAVE;                             /* SAVE must see the unit */
+uptr->flags |= UNIT_ATTABLE | UNIT_ROABLE;
+sim_switches = SWMASK ('O') | SWMASK ('R') | SWMASK ('Q');
+if (attach_unit (uptr, files) != SCPE_OK) {
+    sim_messagef (SCPE_IERR, "overlay: read only attach with no delta failed\n");
+    goto Cleanup;
+    }
+if (((uptr->flags & UNIT_RO) == 0) ||
+    ((sim_fwrite ("ro", 1, 2, uptr->fileref) == 2) &&
+     (fflush (uptr->fileref) != EOF))) {
+    sim_messagef (SCPE_IERR, "overlay: read only attach allowed a write\n");
+    goto Cleanup;
+    }
+detach_unit (uptr);
+if ((f = sim_fopen (OVL_TEST_DELTA, "rb")) != NULL) {
+    fclose (f);
+    sim_messagef (SCPE_IERR, "overlay: read only attach created the delta\n");
+    goto Cleanup;
+    }
+sim_switches = SWMASK ('O');
+if ((attach_unit (uptr, files) != SCPE_OK) ||
+    (uptr->flags & UNIT_RO) ||
+    (sim_fseek (uptr->fileref, OVL_TEST_POS, SEEK_SET) != 0) ||
+    (sim_fwrite ("overlay", 1, 7, uptr->fileref) != 7) ||
+    (fflush (uptr->fileref) == EOF)) {
+    sim_messagef (SCPE_IERR, "overlay: write through the delta failed\n");
+    goto Cleanup;
+    }
+f = sim_fopen (OVL_TEST_BASE, "rb");
+if ((f == NULL) ||
+    (sim_fread (check, 1, sizeof (check), f) != sizeof (check)) ||
+    (memcmp (base, check, sizeof (base)) != 0)) {
+    if (f != NULL)
+        fclose (f);
+    sim_messagef (SCPE_IERR, "overlay: base file changed\n");
+    goto Cleanup;
+    }
+fclose (f);
+if (test_scp_overlay_check (uptr, "write", "overlay") != SCPE_OK)
+    goto Cleanup;
+detach_unit (uptr);
+sim_switches = SWMASK ('O') | SWMASK ('R') | SWMASK ('Q');
+if ((attach_unit (uptr, files) != SCPE_OK) ||
+    (test_scp_overlay_check (uptr, "read only", "overlay") != SCPE_OK))
+    goto Cleanup;
+detach_unit (uptr);
+uptr->flags &= ~UNIT_ROABLE;
+sim_switches = SWMASK ('O') | SWMASK ('R');
+sim_printf ("Read only overlay of a unit which is not ROABLE, an error is expected:\n");
+if (SCPE_BARE_STATUS (attach_unit (uptr, files)) != SCPE_NORO) {
+    sim_messagef (SCPE_IERR, "overlay: read only attach of a unit which is not ROABLE\n");
+    goto Cleanup;
+    }
+uptr->flags |= UNIT_ROABLE;
+sim_switches = SWMASK ('O');
+if (attach_unit (uptr, files) != SCPE_OK)
+    goto Cleanup;
+save = tmpfile ();
+if (save == NULL)
+    goto Cleanup;
+sim_switches = 0;
+if (sim_save (save) != SCPE_OK) {
+    fclose (save);
+    sim_messagef (SCPE_IERR, "overlay: SAVE failed\n");
+    goto Cleanup;
+    }
+detach_unit (uptr);
+rewind (save);
+sim_switches = SWMASK ('Q');
+r = sim_rest (save);
+fclose (save);
+if ((r != SCPE_OK) ||
+    ((uptr->flags & UNIT_ATT) == 0) ||
+    ((uptr->dynflags & UNIT_OVERLAY) == 0)) {
+    r = sim_messagef (SCPE_IERR, "overlay: RESTORE did not reattach the overlay\n");
+    goto Cleanup;
+    }
+r = test_scp_overlay_check (uptr, "after RESTORE", "overlay");
+Cleanup:
+if (uptr->flags & UNIT_ATT)
+    detach_unit (uptr);
+uptr->flags = saved_uflags;
+dptr->flags = saved_dflags;
+sim_switches = saved_switches;
+(void)remove (OVL_TEST_BASE);
+(void)remove (OVL_TEST_DELTA);
+if (r == SCPE_OK)
+    sim_printf ("Overlay write, read only and SAVE/RESTORE tests passed\n");
+return r;
+}
+
 static t_stat test_scp_debug_logging()
 {
 uint32 saved_scp_dev_dbits = sim_scp_dev.dctrl;
@@ -16580,6 +16800,8 @@ if ((strcmp (gbuf, "ALL") == 0) || (strcmp (gbuf, "SCP") == 0)) {
         return sim_messagef (SCPE_IERR, "SCP event sequencing test failed\n");
     if (test_scp_debug_logging () != SCPE_OK)
         return sim_messagef (SCPE_IERR, "SCP debug logging test failed\n");
+    if (test_scp_overlay () != SCPE_OK)
+        return sim_messagef (SCPE_IERR, "SCP overlay attach test failed\n");
 }
 for (i = 0; (dptr = sim_devices[i]) != NULL; i++) {
     t_stat tstat = SCPE_OK;
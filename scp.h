@@ -153,6 +153,7 @@ double sim_gtime (void);
 uint32 sim_grtime (void);
 int32 sim_qcount (void);
 t_stat attach_unit (UNIT *uptr, CONST char *cptr);
+t_stat attach_unit_setvbuf (UNIT *uptr, CONST char *cptr, char *vbuf, size_t vbufsize);
 t_stat detach_unit (UNIT *uptr);
 t_stat assign_device (DEVICE *dptr, const char *cptr);
 t_stat deassign_device (DEVICE *dptr);
@@ -3190,6 +3190,64 @@ key ^= 0x3f;
 return (hash[key>>3] & (1 << (key&0x7)));
 }
 
+/* Compiled address filter.
+
+   The filter addresses supplied to eth_filter are compiled into a small
+   open addressing hash table keyed by the 48 bit MAC address so that
+   received frames can be checked against the filter with a single probe
+   (usually) rather than a comparison against every filter address.
+   Occupied slots have ETH_FILTER_VALID set, so an empty slot is zero. */
+
+#define ETH_FILTER_VALID (((t_uint64)1) << 48)
+
+static t_uint64
+_eth_filter_key(const u_char* mac)
+{
+return ETH_FILTER_VALID        |
+       (((t_uint64)mac[0]) << 40) | (((t_uint64)mac[1]) << 32) |
+       (((t_uint64)mac[2]) << 24) | (((t_uint64)mac[3]) << 16) |
+       (((t_uint64)mac[4]) << 8)  |  ((t_uint64)mac[5]);
+}
+
+static int
+_eth_filter_slot(t_uint64 key)
+{
+uint32 fold = (uint32)(key ^ (key >> 24));
+
+return (int)((fold * 0x9E3779B1) >> (32 - ETH_FILTER_HASH_BITS));
+}
+
+static void
+_eth_filter_compile(ETH_DEV* dev)
+{
+int i;
+
+memset(dev->filter_set, 0, sizeof(dev->filter_set));
+for (i = 0; i < dev->addr_count; i++) {
+  t_uint64 key = _eth_filter_key(dev->filter_address[i]);
+  int slot = _eth_filter_slot(key);
+
+  while ((dev->filter_set[slot] != 0) && (dev->filter_set[slot] != key))
+    slot = (slot + 1) & (ETH_FILTER_HASH_SIZE - 1);
+  dev->filter_set[slot] = key;
+  }
+}
+
+static int
+_eth_filter_lookup(const ETH_DEV* dev, const u_char* mac)
+{
+t_uint64 key = _eth_filter_key(mac);
+int slot = _eth_filter_slot(key);
+
+/* The table is never more than half full, so an empty slot always ends the probe */
+while (dev->filter_set[slot] != 0) {
+  if (dev->filter_set[slot] == key)
+    return 1;
+  slot = (slot + 1) & (ETH_FILTER_HASH_SIZE - 1);
+  }
+return 0;
+}
+
 #if 0
 static int
 _eth_hash_validate(ETH_MAC *MultiCastList, int count, ETH_MULTIHASH hash)
@@ -3685,7 +3743,6 @@ _eth_callback(u_char* info, const struct pcap_pkthdr* header, const u_char* data
 ETH_DEV*  dev = (ETH_DEV*) info;
 int to_me;
 int from_me = 0;
-int i;
 int bpf_used;
 
 if (LOOPBACK_PHYSICAL_RESPONSE(dev, data)) {
@@ -3719,10 +3776,8 @@ switch (dev->eth_api) {
     to_me = 0;
     eth_packet_trace (dev, data, header->len, "received");
 
-    for (i = 0; i < dev->addr_count; i++) {
-      if (memcmp(data, dev->filter_address[i], 6) == 0) to_me = 1;
-      if (memcmp(&data[6], dev->filter_address[i], 6) == 0) from_me = 1;
-    }
+    to_me = _eth_filter_lookup(dev, data);
+    from_me = _eth_filter_lookup(dev, &data[6]);
 
     /* all multicast mode? */
     if (dev->all_multicast && (data[0] & 0x01)) to_me = 1;
@@ -4102,6 +4157,7 @@ if (match_broadcast) {
   ++addr_count;
   }
 dev->addr_count = addr_count;
+_eth_filter_compile(dev);
 
 /* store other flags */
 dev->all_multicast = all_multicast;
@@ -4492,6 +4548,48 @@ if (bpf_compile_skip_count)
 return (errors == 0) ? SCPE_OK : SCPE_IERR;
 }
 
+static
+t_stat eth_test_filter (DEVICE *dptr)
+{
+int errors = 0;
+int i;
+ETH_DEV dev;
+ETH_MAC probe;
+ETH_MAC filter_address[ETH_FILTER_MAX];
+
+memset (&dev, 0, sizeof(dev));
+for (i = 0; i < ETH_FILTER_MAX; i++) {
+  ETH_MAC mac = {0x09, 0x00, 0x2B, 0x00, 0x00, 0x00};
+
+  mac[5] = (u_char)(i * 7);
+  eth_copy_mac (filter_address[i], mac);
+  }
+for (dev.addr_count = 0; dev.addr_count <= ETH_FILTER_MAX; dev.addr_count++) {
+  memcpy (dev.filter_address, filter_address, dev.addr_count * sizeof(ETH_MAC));
+  _eth_filter_compile (&dev);
+  for (i = 0; i < ETH_FILTER_MAX; i++) {
+    if (_eth_filter_lookup (&dev, filter_address[i]) != (i < dev.addr_count)) {
+      sim_printf ("Eth: Compiled filter with %d addresses %s address %d\n",
+                  dev.addr_count, (i < dev.addr_count) ? "missed" : "matched", i);
+      ++errors;
+      }
+    }
+  eth_copy_mac (probe, filter_address[0]);
+  probe[0] ^= 0x80;                         /* mac[0] and mac[3] are xored in the */
+  probe[3] ^= 0x80;                         /* fold, so this lands in the same slot */
+  if (_eth_filter_slot (_eth_filter_key (probe)) !=
+      _eth_filter_slot (_eth_filter_key (filter_address[0]))) {
+    sim_printf ("Eth: Filter probe address does not collide\n");
+    ++errors;
+    }
+  if (_eth_filter_lookup (&dev, probe)) {
+    sim_printf ("Eth: Compiled filter with %d addresses matched a foreign address\n", dev.addr_count);
+    ++errors;
+    }
+  }
+return (errors == 0) ? SCPE_OK : SCPE_IERR;
+}
+
 #include <setjmp.h>
 
 t_stat sim_ether_test (DEVICE *dptr, const char *cptr)
@@ -4502,6 +4600,7 @@ SIM_TEST_INIT;
 sim_printf ("Testing %s device sim_ether APIs\n", dptr->name);
 
 SIM_TEST(eth_test_crc32 (dptr));
+SIM_TEST(eth_test_filter (dptr));
 SIM_TEST(eth_test_bpf (dptr));
 return stat;
 }
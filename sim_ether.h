@@ -158,6 +158,8 @@ extern "C" {
 #define ETH_PROMISC            1                        /* promiscuous mode = true */
 #define ETH_TIMEOUT           -1                        /* read timeout in milliseconds (immediate) */
 #define ETH_FILTER_MAX        20                        /* maximum address filters */
+#define ETH_FILTER_HASH_BITS   6                        /* log2 of compiled filter table size */
+#define ETH_FILTER_HASH_SIZE (1 << ETH_FILTER_HASH_BITS)/* compiled filter table size (> 2*ETH_FILTER_MAX) */
 #define ETH_DEV_NAME_MAX     256                        /* maximum device name size */
 #define ETH_DEV_DESC_MAX     256                        /* maximum device description size */
 #define ETH_MIN_PACKET        60                        /* minimum ethernet packet size */
@@ -270,6 +272,7 @@ struct eth_device {
   ETH_PACK*     read_packet;                            /* read packet */
   ETH_MAC       filter_address[ETH_FILTER_MAX];         /* filtering addresses */
   int           addr_count;                             /* count of filtering addresses */
+  t_uint64      filter_set[ETH_FILTER_HASH_SIZE];       /* compiled filter addresses (open addressing) */
   ETH_BOOL      promiscuous;                            /* promiscuous mode flag */
   ETH_BOOL      all_multicast;                          /* receive all multicast messages */
   ETH_BOOL      hash_filter;                            /* filter using AUTODIN II multicast hash */
@@ -40,6 +40,7 @@
 
    sim_finit         -       initialize package
    sim_fopen         -       open file
+   sim_fopen_overlay -       open a copy-on-write overlay of a file
    sim_fread         -       endian independent read (formerly fxread)
    sim_fwrite        -       endian independent write (formerly fxwrite)
    sim_fseek         -       conditionally extended (>32b) seek (
@@ -1002,6 +1003,357 @@ return FALSE;
 #endif /* defined (__linux__) || defined (__APPLE__) */
 #endif /* defined (_WIN32) */
 
+/* Copy-on-write overlay files
+
+   sim_fopen_overlay returns a stream which reads from a read only base
+   file and keeps everything written to it in a sparse delta file.  The
+   delta starts with a header block and an allocation bitmap holding one
+   bit per OVL_BLKSIZE block, followed by the data area where block n
+   lives at data + n * OVL_BLKSIZE.  A block is copied from the base the
+   first time a write changes it.  Blocks which have never been written are
+   read from the base, which is mapped into memory when possible so that
+   simulators running from the same base share its pages.
+
+   A mode without '+' opens the overlay read only: the delta is read if
+   it exists but is never created or written, and writes to the stream
+   fail.
+
+   The stream is built with fopencookie or funopen, so code using the
+   stdio routines on it works unchanged.  sim_can_seek and sim_set_fsize
+   need a file descriptor and do not work on an overlay.
+*/
+
+#if (defined (__GLIBC__) && defined (_GNU_SOURCE)) || defined (__APPLE__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined (__OpenBSD__)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined (__GLIBC__) && !defined (DONT_DO_LARGEFILE)
+#define ovl_pread       pread64
+#define ovl_pwrite      pwrite64
+#define ovl_off         off64_t
+#else
+#define ovl_pread       pread
+#define ovl_pwrite      pwrite
+#define ovl_off         off_t
+#endif
+
+#define OVL_MAGIC       "SIMHCOW1"
+#define OVL_BLKSIZE     4096
+#define OVL_NBLKS       (4 * 1024 * 1024)       /* 16GB, more if base is larger */
+
+struct ovl_header {
+    char        magic[8];
+    uint32      blksize;
+    uint32      nblks;                          /* Blocks in bitmap */
+    t_uint64    base_size;                      /* Size of base at creation */
+    t_uint64    size;                           /* Size of overlay file */
+    };
+
+static const struct ovl_header ovl_new_header = {
+    {'S', 'I', 'M', 'H', 'C', 'O', 'W', '1'}, OVL_BLKSIZE, OVL_NBLKS, 0, 0};
+
+struct ovl_file {
+    int         base_fd;
+    uint8       *base_map;                      /* Mapped base or NULL */
+    t_offset    base_size;
+    int         fd;                             /* Delta file */
+    uint8       *bitmap;
+    t_offset    data;                           /* Start of data area */
+    t_offset    pos;
+    t_bool      rdonly;                         /* No writes, delta optional */
+    struct ovl_header hdr;
+    };
+
+static int _ovl_put_header (struct ovl_file *o)
+{
+return (ovl_pwrite (o->fd, (void *)&o->hdr, sizeof (o->hdr), 0) == sizeof (o->hdr)) ? 0 : -1;
+}
+
+/* Copy data which has not been written from the base */
+
+static void _ovl_base (struct ovl_file *o, t_offset pos, uint8 *buf, size_t n)
+{
+ssize_t c = 0;
+
+if (pos < o->base_size) {
+    c = (ssize_t)MIN ((t_offset)n, o->base_size - pos);
+    if (o->base_map != NULL)
+        memcpy (buf, o->base_map + pos, c);
+    else
+        c = ovl_pread (o->base_fd, buf, c, (ovl_off)pos);
+    if (c < 0)
+        c = 0;
+    }
+memset (buf + c, 0, n - c);
+}
+
+static ssize_t _ovl_read (struct ovl_file *o, uint8 *buf, size_t len)
+{
+size_t done = 0;
+
+while ((done < len) && (o->pos < (t_offset)o->hdr.size)) {
+    t_offset blk = o->pos / OVL_BLKSIZE;
+    size_t off = (size_t)(o->pos % OVL_BLKSIZE);
+    size_t n = MIN (len - done, OVL_BLKSIZE - off);
+    ssize_t r;
+
+    if ((t_offset)n > (t_offset)o->hdr.size - o->pos)
+        n = (size_t)((t_offset)o->hdr.size - o->pos);
+    if ((blk < (t_offset)o->hdr.nblks) &&
+        (o->bitmap[blk >> 3] & (1 << (blk & 7)))) {
+        r = ovl_pread (o->fd, buf + done, n, (ovl_off)(o->data + blk * OVL_BLKSIZE + off));
+        if (r < 0)
+            return (done != 0) ? (ssize_t)done : -1;
+        memset (buf + done + r, 0, n - r);
+        }
+    else
+        _ovl_base (o, o->pos, buf + done, n);
+    done += n;
+    o->pos += n;
+    }
+return (ssize_t)done;
+}
+
+static ssize_t _ovl_write (struct ovl_file *o, const uint8 *buf, size_t len)
+{
+size_t done = 0;
+
+if (o->rdonly) {
+    errno = EBADF;
+    return -1;
+    }
+while (done < len) {
+    t_offset blk = o->pos / OVL_BLKSIZE;
+    size_t off = (size_t)(o->pos % OVL_BLKSIZE);
+    size_t n = MIN (len - done, OVL_BLKSIZE - off);
+    t_offset where = o->data + blk * OVL_BLKSIZE;
+    uint8 bit = (uint8)(1 << (blk & 7));
+
+    if (blk >= (t_offset)o->hdr.nblks) {
+        errno = EFBIG;
+        break;
+        }
+    if ((o->bitmap[blk >> 3] & bit) == 0) {     /* First write, copy block */
+        uint8 blkbuf[OVL_BLKSIZE];
+
+        _ovl_base (o, blk * OVL_BLKSIZE, blkbuf, OVL_BLKSIZE);
+        if (memcmp (blkbuf + off, buf + done, n) == 0)
+            goto next;                          /* No change, stay sparse */
+        memcpy (blkbuf + off, buf + done, n);
+        if (ovl_pwrite (o->fd, blkbuf, OVL_BLKSIZE, (ovl_off)where) != OVL_BLKSIZE)
+            break;
+        o->bitmap[blk >> 3] |= bit;
+        if (ovl_pwrite (o->fd, &o->bitmap[blk >> 3], 1, (ovl_off)(OVL_BLKSIZE + (blk >> 3))) != 1)
+            break;
+        }
+    else {
+        if (ovl_pwrite (o->fd, buf + done, n, (ovl_off)(where + off)) != (ssize_t)n)
+            break;
+        }
+next:
+    done += n;
+    o->pos += n;
+    if (o->pos > (t_offset)o->hdr.size) {       /* Grew, update header */
+        o->hdr.size = (t_uint64)o->pos;
+        if (_ovl_put_header (o))
+            break;
+        }
+    }
+if ((done == 0) && (len != 0))
+    return -1;
+return (ssize_t)done;
+}
+
+static int _ovl_seek (struct ovl_file *o, t_offset *offset, int whence)
+{
+t_offset pos;
+
+switch (whence) {
+    case SEEK_SET:
+        pos = *offset;
+        break;
+    case SEEK_CUR:
+        pos = o->pos + *offset;
+        break;
+    case SEEK_END:
+        pos = (t_offset)o->hdr.size + *offset;
+        break;
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+if (pos < 0) {
+    errno = EINVAL;
+    return -1;
+    }
+*offset = o->pos = pos;
+return 0;
+}
+
+static int _ovl_close (struct ovl_file *o)
+{
+int r = 0;
+
+if ((o->fd != -1) && (o->bitmap != NULL) && !o->rdonly && _ovl_put_header (o))
+    r = -1;
+if ((o->fd != -1) && close (o->fd))
+    r = -1;
+if (o->base_map != NULL)
+    munmap (o->base_map, (size_t)o->base_size);
+if (o->base_fd != -1)
+    close (o->base_fd);
+free (o->bitmap);
+free (o);
+return r;
+}
+
+#if defined (__GLIBC__)
+static ssize_t _ovl_cookie_read (void *cookie, char *buf, size_t size)
+{
+return _ovl_read ((struct ovl_file *)cookie, (uint8 *)buf, size);
+}
+
+static ssize_t _ovl_cookie_write (void *cookie, const char *buf, size_t size)
+{
+ssize_t r = _ovl_write ((struct ovl_file *)cookie, (const uint8 *)buf, size);
+
+return (r < 0) ? 0 : r;                         /* 0 means error here */
+}
+
+static int _ovl_cookie_seek (void *cookie, off64_t *offset, int whence)
+{
+t_offset pos = (t_offset)*offset;
+
+if (_ovl_seek ((struct ovl_file *)cookie, &pos, whence))
+    return -1;
+*offset = (off64_t)pos;
+return 0;
+}
+
+static int _ovl_cookie_close (void *cookie)
+{
+return _ovl_close ((struct ovl_file *)cookie);
+}
+#else
+static int _ovl_fun_read (void *cookie, char *buf, int size)
+{
+return (int)_ovl_read ((struct ovl_file *)cookie, (uint8 *)buf, (size_t)size);
+}
+
+static int _ovl_fun_write (void *cookie, const char *buf, int size)
+{
+return (int)_ovl_write ((struct ovl_file *)cookie, (const uint8 *)buf, (size_t)size);
+}
+
+static fpos_t _ovl_fun_seek (void *cookie, fpos_t offset, int whence)
+{
+t_offset pos = (t_offset)offset;
+
+if (_ovl_seek ((struct ovl_file *)cookie, &pos, whence))
+    return (fpos_t)-1;
+return (fpos_t)pos;
+}
+
+static int _ovl_fun_close (void *cookie)
+{
+return _ovl_close ((struct ovl_file *)cookie);
+}
+#endif
+
+FILE *sim_fopen_overlay (const char *base, const char *delta, const char *mode)
+{
+char namebuf[PATH_MAX + 1];
+struct ovl_file *o;
+struct stat statb;
+FILE *f = NULL;
+int err;
+#if defined (__GLIBC__)
+cookie_io_functions_t io;
+#endif
+
+o = (struct ovl_file *)calloc (1, sizeof (*o));
+if (o == NULL)
+    return NULL;
+o->base_fd = o->fd = -1;
+o->rdonly = (strchr (mode, '+') == NULL);
+if ((NULL == _sim_expand_homedir (base, namebuf, sizeof (namebuf))) ||
+    ((o->base_fd = open (namebuf, O_RDONLY)) == -1) ||
+    (fstat (o->base_fd, &statb) != 0))
+    goto fail;
+o->base_size = (t_offset)statb.st_size;
+if ((o->base_size > 0) &&
+    ((t_offset)(size_t)o->base_size == o->base_size)) {
+    o->base_map = (uint8 *)mmap (NULL, (size_t)o->base_size, PROT_READ, MAP_SHARED, o->base_fd, 0);
+    if (o->base_map == (uint8 *)MAP_FAILED)     /* Read it instead */
+        o->base_map = NULL;
+    }
+if (NULL == _sim_expand_homedir (delta, namebuf, sizeof (namebuf)))
+    goto fail;
+o->fd = open (namebuf, o->rdonly ? O_RDONLY : O_RDWR);
+if (o->fd == -1) {                              /* New delta file? */
+    if ((errno != ENOENT) ||
+        (!o->rdonly &&
+         ((o->fd = open (namebuf, O_RDWR | O_CREAT | O_EXCL, 0666)) == -1)))
+        goto fail;
+    o->hdr = ovl_new_header;
+    while (((t_offset)o->hdr.nblks * OVL_BLKSIZE < o->base_size) &&
+           (o->hdr.nblks < 0x80000000))
+        o->hdr.nblks *= 2;
+    o->hdr.base_size = o->hdr.size = (t_uint64)o->base_size;
+    if (!o->rdonly && _ovl_put_header (o))      /* Read only has no delta */
+        goto fail;
+    }
+else {
+    if ((ovl_pread (o->fd, &o->hdr, sizeof (o->hdr), 0) != sizeof (o->hdr)) ||
+        (memcmp (o->hdr.magic, OVL_MAGIC, sizeof (o->hdr.magic)) != 0) ||
+        (o->hdr.blksize != OVL_BLKSIZE) ||
+        (o->hdr.nblks == 0) ||
+        ((o->hdr.nblks % (8 * OVL_BLKSIZE)) != 0) ||
+        ((t_offset)o->hdr.base_size != o->base_size)) { /* Base changed? */
+        errno = EINVAL;
+        goto fail;
+        }
+    }
+o->data = OVL_BLKSIZE + (t_offset)(o->hdr.nblks / 8);
+o->bitmap = (uint8 *)calloc (o->hdr.nblks / 8, 1);
+if (o->bitmap == NULL) {
+    errno = ENOMEM;
+    goto fail;
+    }
+if ((o->fd != -1) &&
+    (ovl_pread (o->fd, o->bitmap, o->hdr.nblks / 8, OVL_BLKSIZE) < 0))
+    goto fail;
+#if defined (__GLIBC__)
+io.read = _ovl_cookie_read;
+io.write = _ovl_cookie_write;
+io.seek = _ovl_cookie_seek;
+io.close = _ovl_cookie_close;
+f = fopencookie (o, o->rdonly ? "r" : "r+", io);
+#else
+f = funopen (o, _ovl_fun_read, o->rdonly ? NULL : _ovl_fun_write, _ovl_fun_seek, _ovl_fun_close);
+#endif
+if (f != NULL)
+    return f;
+fail:
+err = errno;
+free (o->bitmap);                               /* Don't rewrite header */
+o->bitmap = NULL;
+_ovl_close (o);
+errno = err;
+return NULL;
+}
+
+#else /* no fopencookie or funopen */
+
+FILE *sim_fopen_overlay (const char *base, const char *delta, const char *mode)
+{
+errno = ENOSYS;
+return NULL;
+}
+
+#endif
+
 #if defined(__VAX)
 /*
  * We provide a 'basic' snprintf, which 'might' overrun a buffer, but
@@ -60,6 +60,7 @@ typedef int32        t_offset;
 #endif
 #endif
 FILE *sim_fopen (const char *file, const char *mode);
+FILE *sim_fopen_overlay (const char *base, const char *delta, const char *mode);
 int sim_fseek (FILE *st, t_addr offset, int whence);
 int sim_fseeko (FILE *st, t_offset offset, int whence);
 t_bool sim_can_seek (FILE *st);
@@ -1418,6 +1418,117 @@ closesocket (sock);
 
 #endif                                                  /* end else !implemented */
 
+/* Socket readiness sets
+
+   On Linux these are epoll instances with edge triggered registrations, so
+   the cost of a wait is proportional to the number of sockets which have
+   become readable rather than to the number of sockets registered.  Tokens
+   are carried in the event data and returned to the caller unchanged.
+   Elsewhere sim_sock_poll_open fails and the caller is expected to fall
+   back to reading each socket.
+*/
+
+#if defined (__linux) || defined (__linux__)
+#include <sys/epoll.h>
+
+struct SIM_SOCK_POLLSET {
+    int     epfd;
+    };
+
+SIM_SOCK_POLLSET *sim_sock_poll_open (void)
+{
+SIM_SOCK_POLLSET *ps;
+int epfd = epoll_create (64);                           /* size is only a hint */
+
+if (epfd < 0)
+    return NULL;
+ps = (SIM_SOCK_POLLSET *)calloc (1, sizeof (*ps));
+if (ps == NULL) {
+    close (epfd);
+    return NULL;
+    }
+ps->epfd = epfd;
+return ps;
+}
+
+int sim_sock_poll_add (SIM_SOCK_POLLSET *ps, SOCKET sock, int token)
+{
+struct epoll_event ev;
+
+if ((ps == NULL) || (sock == INVALID_SOCKET) || (sock == 0))
+    return -1;
+memset (&ev, 0, sizeof (ev));
+ev.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+ev.data.u32 = (unsigned int)token;
+if (epoll_ctl (ps->epfd, EPOLL_CTL_ADD, sock, &ev) == 0)
+    return 0;
+if ((errno == EEXIST) &&                                /* fd reused after close? */
+    (epoll_ctl (ps->epfd, EPOLL_CTL_MOD, sock, &ev) == 0))
+    return 0;
+return -1;
+}
+
+int sim_sock_poll_del (SIM_SOCK_POLLSET *ps, SOCKET sock)
+{
+struct epoll_event ev;                                  /* pre 2.6.9 kernels need non NULL */
+
+if ((ps == NULL) || (sock == INVALID_SOCKET) || (sock == 0))
+    return -1;
+return epoll_ctl (ps->epfd, EPOLL_CTL_DEL, sock, &ev);
+}
+
+int sim_sock_poll_wait (SIM_SOCK_POLLSET *ps, int *tokens, int max_tokens, int msec)
+{
+struct epoll_event ev[64];
+int i, n;
+
+if ((ps == NULL) || (max_tokens <= 0))
+    return -1;
+if (max_tokens > (int)(sizeof (ev) / sizeof (ev[0])))
+    max_tokens = (int)(sizeof (ev) / sizeof (ev[0]));
+n = epoll_wait (ps->epfd, ev, max_tokens, msec);
+if (n < 0)
+    return (errno == EINTR) ? 0 : -1;
+for (i = 0; i < n; i++)
+    tokens[i] = (int)ev[i].data.u32;
+return n;
+}
+
+void sim_sock_poll_close (SIM_SOCK_POLLSET *ps)
+{
+if (ps == NULL)
+    return;
+close (ps->epfd);
+free (ps);
+}
+
+#else                                                   /* no readiness facility */
+
+SIM_SOCK_POLLSET *sim_sock_poll_open (void)
+{
+return NULL;
+}
+
+int sim_sock_poll_add (SIM_SOCK_POLLSET *ps, SOCKET sock, int token)
+{
+return -1;
+}
+
+int sim_sock_poll_del (SIM_SOCK_POLLSET *ps, SOCKET sock)
+{
+return -1;
+}
+
+int sim_sock_poll_wait (SIM_SOCK_POLLSET *ps, int *tokens, int max_tokens, int msec)
+{
+return -1;
+}
+
+void sim_sock_poll_close (SIM_SOCK_POLLSET *ps)
+{
+}
+#endif
+
 #ifdef  __cplusplus
 }
 #endif
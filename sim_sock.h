@@ -134,6 +134,19 @@ void sim_close_sock (SOCKET sock);
 const char *sim_get_err_sock (const char *emsg);
 SOCKET sim_err_sock (SOCKET sock, const char *emsg);
 int sim_getnames_sock (SOCKET sock, char **socknamebuf, char **peernamebuf);
+/* Socket readiness sets.  Where the host provides a scalable readiness
+   notification facility (epoll on Linux) sockets may be registered with a
+   caller supplied token and later waited on without rebuilding fd_sets.
+   Registration is edge triggered: a token is reported once when new data
+   arrives and the caller must read until the socket is drained.  On hosts
+   without such a facility sim_sock_poll_open returns NULL and callers fall
+   back to polling each socket directly. */
+typedef struct SIM_SOCK_POLLSET SIM_SOCK_POLLSET;
+SIM_SOCK_POLLSET *sim_sock_poll_open (void);
+int sim_sock_poll_add (SIM_SOCK_POLLSET *ps, SOCKET sock, int token);
+int sim_sock_poll_del (SIM_SOCK_POLLSET *ps, SOCKET sock);
+int sim_sock_poll_wait (SIM_SOCK_POLLSET *ps, int *tokens, int max_tokens, int msec);
+void sim_sock_poll_close (SIM_SOCK_POLLSET *ps);
 void sim_init_sock (void);
 void sim_cleanup_sock (void);
 
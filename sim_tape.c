@@ -101,6 +101,11 @@
 #include <pthread.h>
 #endif
 
+#if defined (__linux__) || defined (__APPLE__) || defined (__CYGWIN__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined (__OpenBSD__)
+#include <sys/mman.h>
+#define SIM_TAPE_MMAP 1                                 /* map read only images */
+#endif
+
 static struct sim_tape_fmt {
     const char          *name;                          /* name */
     int32               uflags;                         /* unit flags */
@@ -139,6 +144,21 @@ static t_addr sim_tape_tpc_fnd (UNIT *uptr, t_addr *map);
 static void sim_tape_data_trace (UNIT *uptr, const uint8 *data, size_t len, const char* txt, int detail, uint32 reason);
 static t_stat tape_erase_fwd (UNIT *uptr, t_mtrlnt gap_size);
 static t_stat tape_erase_rev (UNIT *uptr, t_mtrlnt gap_size);
+static void _sim_tape_p7b_index_free (UNIT *uptr);
+static void _sim_tape_map (UNIT *uptr);
+static void _sim_tape_unmap (UNIT *uptr);
+
+/* Size of the stdio buffer given to on-disk tape images.  Sequential reads
+   of small records are satisfied from the buffer and sequential writes are
+   collected into writes of this size; records larger than the buffer are
+   transferred directly by stdio. */
+
+#define TAPE_IOBUF_SIZE (64*1024)
+
+struct p7b_rec {
+    t_addr              pos;                /* offset of start of record */
+    t_bool              tmk;                /* record consists only of EOF characters */
+    };
 
 struct tape_context {
     DEVICE              *dptr;              /* Device for unit (access to debug flags) */
@@ -165,6 +185,16 @@ struct tape_context {
     TAPE_PCALLBACK      callback;
     t_stat              io_status;
 #endif
+    uint8               *iobuf;             /* stdio buffer for on-disk images */
+    t_bool              wr_pending;         /* file position follows last sequential write */
+    t_addr              wr_pos;             /* file position after that write */
+    const uint8         *map;               /* read only image mapping (NULL if not mapped) */
+    t_addr              map_size;           /* size of mapping */
+    t_bool              map_data_ok;        /* map_data locates the record just spaced over */
+    t_addr              map_data;           /* offset of that record's data */
+    struct p7b_rec      *p7b_index;         /* P7B record index (NULL if not built) */
+    uint32              p7b_count;          /* P7B records in index */
+    t_addr              p7b_size;           /* P7B image size covered by index */
     };
 #define tape_ctx up8                        /* Field in Unit structure which points to the tape_context */
 
@@ -647,6 +677,7 @@ t_bool had_debug = (sim_deb != NULL);
 uint32 starting_dctrl = uptr->dctrl;
 int32 saved_switches = sim_switches;
 MEMORY_TAPE *tape = NULL;
+uint8 *iobuf = NULL;
 
 if ((dptr = find_dev_from_unit (uptr)) == NULL)
     return SCPE_NOATT;
@@ -894,11 +925,13 @@ switch (MT_GET_FMT (uptr)) {
             return sim_messagef (SCPE_ARG, "TAR format block size of %" SIZE_T_FMT "u is not a multiple of 512\n", uptr->recsize);
         sim_switches |= SWMASK ('E');                   /* The TAR file must exist */
         /* fall through */
-    default:
-        r = attach_unit (uptr, (CONST char *)cptr);     /* attach unit */
+    default:                                            /* on-disk image */
+        iobuf = (uint8 *)malloc (TAPE_IOBUF_SIZE);      /* read ahead and write behind */
+        r = attach_unit_setvbuf (uptr, (CONST char *)cptr, (char *)iobuf, TAPE_IOBUF_SIZE);
         break;
     }
 if (r != SCPE_OK) {                                     /* error? */
+    free (iobuf);                                       /* stream never opened */
     if (MT_GET_FMT (uptr) >= MTUF_F_ANSI) {
         r = sim_messagef (r, "Error opening %s format internal tape image generated from: '%s'\n", _sim_tape_format_name (uptr), cptr);
         memory_free_tape (uptr->fileref);
@@ -926,6 +959,9 @@ uptr->tape_ctx = ctx = (struct tape_context *)calloc(1, sizeof(struct tape_conte
 ctx->dptr = dptr;                                       /* save DEVICE pointer */
 ctx->dbit = dbit;                                       /* save debug bit */
 ctx->auto_format = auto_format;                         /* save that we auto selected format */
+ctx->iobuf = iobuf;                                     /* stdio buffer set at open */
+if (MT_GET_FMT (uptr) < MTUF_F_ANSI)                    /* on-disk image? */
+    _sim_tape_map (uptr);                               /* map read only images */
 
 switch (MT_GET_FMT (uptr)) {                            /* case on format */
 
@@ -1004,8 +1040,10 @@ if (MT_GET_FMT (uptr) >= MTUF_F_ANSI) {
     uptr->flags &= ~UNIT_ATT;
     r = SCPE_OK;
     }
-else
+else {
+    _sim_tape_unmap (uptr);
     r = detach_unit (uptr);                             /* detach unit */
+    }
 if (r != SCPE_OK)
     return r;
 switch (f) {                                            /* case on format */
@@ -1025,6 +1063,9 @@ uptr->tape_eom = 0;
 uptr->pos = 0;
 MT_CLR_PNU (uptr);
 MT_CLR_INMRK (uptr);                                    /* Not within a TAR tapemark */
+_sim_tape_p7b_index_free (uptr);
+if (ctx)
+    free (ctx->iobuf);                                  /* stream is closed now */
 free (uptr->tape_ctx);
 uptr->tape_ctx = NULL;
 uptr->io_flush = NULL;
@@ -1115,11 +1156,43 @@ if (sim_deb && ((uptr->dctrl | ctx->dptr->dctrl) & reason))
 
 static int sim_tape_seek (UNIT *uptr, t_addr pos)
 {
+struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+
+if (ctx)
+    ctx->wr_pending = FALSE;
 if (MT_GET_FMT (uptr) < MTUF_F_ANSI)
     return sim_fseek (uptr->fileref, pos, SEEK_SET);
 return 0;
 }
 
+/* Position for a write.
+
+   Seeking a stdio stream which holds buffered output forces the buffer to be
+   written, so consecutive records written at the position where the previous
+   write ended skip the seek.  Their data then accumulates in the unit's I/O
+   buffer and reaches the file in large writes.  Any other positioning (or a
+   read, which always starts with sim_tape_seek) ends the run.
+*/
+
+static int sim_tape_seek_wr (UNIT *uptr, t_addr pos)
+{
+struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+
+if (ctx && ctx->wr_pending && (ctx->wr_pos == pos))
+    return 0;
+return sim_tape_seek (uptr, pos);
+}
+
+static void sim_tape_wr_done (UNIT *uptr)
+{
+struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+
+if (ctx == NULL)
+    return;
+ctx->wr_pending = TRUE;
+ctx->wr_pos = uptr->pos;
+}
+
 static t_offset sim_tape_size (UNIT *uptr)
 {
 if (MT_GET_FMT (uptr) < MTUF_F_ANSI)
@@ -1127,6 +1200,262 @@ if (MT_GET_FMT (uptr) < MTUF_F_ANSI)
 return uptr->tape_eom;                   /* Virtual tape images: record/TM count */
 }
 
+/* Memory mapped read only images
+
+   SIMH and E11 format images attached read only are mapped into memory.
+   Record markers and data are then taken straight from the mapping, so
+   reading and spacing over ordinary records and tape marks needs no stdio
+   calls at all.  Anything out of the ordinary (erase gaps, end of medium,
+   a damaged record) is left to the general routines, which still use the
+   open file.
+*/
+
+static void _sim_tape_map (UNIT *uptr)
+{
+#if defined (SIM_TAPE_MMAP)
+struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+t_offset size;
+void *map;
+
+if ((ctx == NULL) ||
+    ((MT_GET_FMT (uptr) != MTUF_F_STD) && (MT_GET_FMT (uptr) != MTUF_F_E11)) ||
+    !(uptr->flags & UNIT_RO))
+    return;
+size = sim_fsize_ex (uptr->fileref);
+if ((size == 0) || (size != (t_offset)(size_t)size))
+    return;
+map = mmap (NULL, (size_t)size, PROT_READ, MAP_SHARED, fileno (uptr->fileref), 0);
+if (map == MAP_FAILED)
+    return;
+ctx->map = (const uint8 *)map;
+ctx->map_size = (t_addr)size;
+#endif
+}
+
+static void _sim_tape_unmap (UNIT *uptr)
+{
+#if defined (SIM_TAPE_MMAP)
+struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+
+if ((ctx == NULL) || (ctx->map == NULL))
+    return;
+munmap ((void *)ctx->map, (size_t)ctx->map_size);
+ctx->map = NULL;
+ctx->map_size = 0;
+ctx->map_data_ok = FALSE;
+#endif
+}
+
+static t_mtrlnt _sim_tape_map_lnt (struct tape_context *ctx, t_addr pos)
+{
+t_mtrlnt lnt;
+
+memcpy (&lnt, ctx->map + pos, sizeof (lnt));
+return lnt;
+}
+
+/* Space forward over a record or tape mark in a mapped image.  Returns TRUE
+   with the status in *st if the object was handled, FALSE if the general
+   routine must be used.
+*/
+
+static t_bool _sim_tape_map_rdlntf (UNIT *uptr, t_mtrlnt *bc, t_stat *st)
+{
+struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+t_mtrlnt lnt, sbc;
+t_addr end;
+
+if (ctx == NULL)
+    return FALSE;
+ctx->map_data_ok = FALSE;
+if ((ctx->map == NULL) ||
+    (uptr->pos + sizeof (t_mtrlnt) > ctx->map_size))
+    return FALSE;
+lnt = _sim_tape_map_lnt (ctx, uptr->pos);
+if (lnt == MTR_TMK) {                                   /* tape mark? */
+    uptr->pos += sizeof (t_mtrlnt);
+    *bc = lnt;
+    *st = MTSE_TMK;
+    return TRUE;
+    }
+if ((lnt & 0xFF000000) == 0xFF000000)                   /* gap or EOM? */
+    return FALSE;
+sbc = MTR_L (lnt);
+end = uptr->pos + sizeof (t_mtrlnt) + (MT_GET_FMT (uptr) == MTUF_F_STD ? (sbc + 1) & ~1 : sbc);
+if ((end + sizeof (t_mtrlnt) > ctx->map_size) ||        /* truncated or */
+    (_sim_tape_map_lnt (ctx, end) != lnt))              /* length mismatch? */
+    return FALSE;
+ctx->map_data = uptr->pos + sizeof (t_mtrlnt);
+ctx->map_data_ok = TRUE;
+uptr->pos = end + sizeof (t_mtrlnt);
+*bc = lnt;
+*st = MTSE_OK;
+return TRUE;
+}
+
+/* Space backward over a record or tape mark in a mapped image. */
+
+static t_bool _sim_tape_map_rdlntr (UNIT *uptr, t_mtrlnt *bc, t_stat *st)
+{
+struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+t_mtrlnt lnt, sbc;
+t_addr len;
+
+if (ctx == NULL)
+    return FALSE;
+ctx->map_data_ok = FALSE;
+if ((ctx->map == NULL) ||
+    (uptr->pos < sizeof (t_mtrlnt)) ||
+    (uptr->pos > ctx->map_size))
+    return FALSE;
+lnt = _sim_tape_map_lnt (ctx, uptr->pos - sizeof (t_mtrlnt));
+if (lnt == MTR_TMK) {                                   /* tape mark? */
+    uptr->pos -= sizeof (t_mtrlnt);
+    *bc = lnt;
+    *st = MTSE_TMK;
+    return TRUE;
+    }
+if ((lnt & 0xFF000000) == 0xFF000000)                   /* gap? */
+    return FALSE;
+sbc = MTR_L (lnt);
+len = 2 * sizeof (t_mtrlnt) + (MT_GET_FMT (uptr) == MTUF_F_STD ? (sbc + 1) & ~1 : sbc);
+if (len > uptr->pos)                                    /* runs off the front? */
+    return FALSE;
+uptr->pos -= len;
+ctx->map_data = uptr->pos + sizeof (t_mtrlnt);
+ctx->map_data_ok = TRUE;
+*bc = lnt;
+*st = MTSE_OK;
+return TRUE;
+}
+
+/* P7B record index
+
+   A P7B image has no length words; the only way to find the length of a
+   record is to read forward (or backward) to the next byte which has the
+   start of record bit set.  To avoid repeating that byte at a time scan for
+   every read, space and backspace, the whole image is scanned once, in
+   large blocks, the first time a record length is needed and the offset of
+   each record start is remembered along with whether the record is a tape
+   mark.  Record lengths in either direction are then found with a binary
+   search.  Any write to the image discards the index; it is rebuilt on the
+   next read.
+*/
+
+#define P7B_INDEX_BUFSZ 65536
+
+static void _sim_tape_p7b_index_free (UNIT *uptr)
+{
+struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+
+if (ctx == NULL)
+    return;
+free (ctx->p7b_index);
+ctx->p7b_index = NULL;
+ctx->p7b_count = 0;
+ctx->p7b_size = 0;
+}
+
+static t_bool _sim_tape_p7b_index_build (UNIT *uptr)
+{
+struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+struct p7b_rec *idx = NULL, *nidx;
+uint32 count = 0, max = 0;
+t_addr offset = 0;
+t_bool all_eof = TRUE;
+size_t i, rdcnt;
+uint8 *buf;
+
+buf = (uint8 *)malloc (P7B_INDEX_BUFSZ);
+if (buf == NULL)
+    return FALSE;
+if (sim_fseek (uptr->fileref, 0, SEEK_SET)) {
+    free (buf);
+    return FALSE;
+    }
+while ((rdcnt = sim_fread (buf, sizeof (uint8), P7B_INDEX_BUFSZ, uptr->fileref)) > 0) {
+    for (i = 0; i < rdcnt; i++, offset++) {
+        uint8 c = buf[i];
+
+        if ((offset == 0) || (c & P7B_SOR)) {           /* start of record? */
+            if (count > 0)
+                idx[count - 1].tmk = all_eof;
+            if (count == max) {
+                max = max ? 2 * max : 1024;
+                nidx = (struct p7b_rec *)realloc (idx, max * sizeof (*idx));
+                if (nidx == NULL) {
+                    free (idx);
+                    free (buf);
+                    return FALSE;
+                    }
+                idx = nidx;
+                }
+            idx[count].pos = offset;
+            idx[count].tmk = FALSE;
+            ++count;
+            all_eof = TRUE;
+            }
+        if ((c & P7B_DPAR) != P7B_EOF)
+            all_eof = FALSE;
+        }
+    }
+free (buf);
+if (ferror (uptr->fileref)) {
+    clearerr (uptr->fileref);
+    free (idx);
+    return FALSE;
+    }
+if (count > 0)
+    idx[count - 1].tmk = all_eof;
+ctx->p7b_index = idx;
+ctx->p7b_count = count;
+ctx->p7b_size = offset;
+return TRUE;
+}
+
+/* Look up the P7B record following (forward) or preceding (reverse) the
+   current position.  Returns TRUE with the record length and tape mark
+   indication if the index answers the question, or FALSE if the caller
+   must scan the image.  A length of zero returned forward means the
+   position is at the end of the image.
+*/
+
+static t_bool _sim_tape_p7b_index_find (UNIT *uptr, t_bool forward, t_mtrlnt *sbc, t_bool *tmk)
+{
+struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+uint32 lo, hi, mid;
+t_addr pos = uptr->pos, end;
+
+if ((ctx == NULL) ||
+    ((ctx->p7b_index == NULL) && !_sim_tape_p7b_index_build (uptr)))
+    return FALSE;
+if (forward && (pos >= ctx->p7b_size)) {                /* at end of image? */
+    *sbc = 0;
+    *tmk = FALSE;
+    return TRUE;
+    }
+if ((ctx->p7b_count == 0) || (pos > ctx->p7b_size))
+    return FALSE;
+lo = 0;                                                 /* find last start <= pos */
+hi = ctx->p7b_count;                                    /* (last start < pos for reverse) */
+while (hi - lo > 1) {
+    mid = lo + (hi - lo) / 2;
+    if ((ctx->p7b_index[mid].pos < pos) ||
+        (forward && (ctx->p7b_index[mid].pos == pos)))
+        lo = mid;
+    else
+        hi = mid;
+    }
+end = (lo + 1 < ctx->p7b_count) ? ctx->p7b_index[lo + 1].pos : ctx->p7b_size;
+if (forward ? (ctx->p7b_index[lo].pos != pos) :         /* not on a record boundary? */
+              ((ctx->p7b_index[lo].pos >= pos) || (end != pos)))
+    return FALSE;
+*sbc = (t_mtrlnt)(end - ctx->p7b_index[lo].pos);
+*tmk = ctx->p7b_index[lo].tmk;
+return TRUE;
+}
+
+
 /* Read record length forward (internal routine).
 
    Inputs:
@@ -1245,6 +1574,9 @@ if ((uptr->tape_eom > 0) &&
     return MTSE_EOM;                                    /*     and quit with I/O error status */
     }
 
+if (_sim_tape_map_rdlntf (uptr, bc, &status))           /* ordinary object in mapped image? */
+    return status;
+
 if (sim_tape_seek (uptr, uptr->pos)) {                  /* set the initial tape position; if it fails */
     MT_SET_PNU (uptr);                                  /*   then set position not updated */
     return sim_tape_ioerr (uptr);                       /*     and quit with I/O error status */
@@ -1418,6 +1750,11 @@ switch (f) {                                       /* otherwise the read method
         break;
 
     case MTUF_F_P7B:
+        if (_sim_tape_p7b_index_find (uptr, TRUE, &sbc, &all_eof)) {
+            if (sbc == 0)                               /* no data? eom */
+                status = MTSE_EOM;
+            }
+        else
         for (sbc = 0, all_eof = 1; ; sbc++) {           /* loop thru record */
             (void)sim_fread (&c, sizeof (uint8), 1, uptr->fileref);
 
@@ -1617,6 +1954,9 @@ if ((uptr->flags & UNIT_ATT) == 0)                      /* if the unit is not at
 if (sim_tape_bot (uptr))                                /* if the unit is positioned at the BOT */
     return MTSE_BOT;                                    /*   then reading backward is not possible */
 
+if (_sim_tape_map_rdlntr (uptr, bc, &status))           /* ordinary object in mapped image? */
+    return status;
+
 switch (f) {                                            /* otherwise the read method depends on the tape format */
 
     case MTUF_F_STD:
@@ -1735,6 +2075,7 @@ switch (f) {                                            /* otherwise the read me
             size_t bytes_in_buf = 0;
             size_t read_size;
 
+            if (!_sim_tape_p7b_index_find (uptr, FALSE, &sbc, &all_eof))  /* not indexed? scan back */
             for (sbc = 1, all_eof = 1; (t_addr) sbc <= uptr->pos ; sbc++) {
                 if (bytes_in_buf == 0) {                /* Need to Fill Buffer */
                     if (buf_offset < BUF_SZ) {
@@ -1935,7 +2276,11 @@ if (rbc > max) {                                        /* rec out of range? */
     uptr->pos = opos;
     return MTSE_INVRL;
     }
-if (f < MTUF_F_ANSI) {
+if (ctx->map_data_ok) {                                 /* mapped image? */
+    memcpy (buf, ctx->map + ctx->map_data, rbc);
+    i = rbc;
+    }
+else if (f < MTUF_F_ANSI) {
     i = (t_mtrlnt) sim_fread (buf, sizeof (uint8), rbc, uptr->fileref); /* read record */
     if (ferror (uptr->fileref)) {                           /* error? */
         MT_SET_PNU (uptr);
@@ -2009,7 +2354,11 @@ if (st != MTSE_OK) {
 *bc = rbc = MTR_L (tbc);                                /* strip error flag */
 if (rbc > max)                                          /* rec out of range? */
     return MTSE_INVRL;
-if (f < MTUF_F_ANSI) {
+if (ctx->map_data_ok) {                                 /* mapped image? */
+    memcpy (buf, ctx->map + ctx->map_data, rbc);
+    i = rbc;
+    }
+else if (f < MTUF_F_ANSI) {
     i = (t_mtrlnt) sim_fread (buf, sizeof (uint8), rbc, uptr->fileref); /* read record */
     if (ferror (uptr->fileref))                             /* error? */
         return sim_tape_ioerr (uptr);
@@ -2074,7 +2423,7 @@ if (sim_tape_wrp (uptr))                                /* write prot? */
     return MTSE_WRP;
 if (sbc == 0)                                           /* nothing to do? */
     return MTSE_OK;
-if (sim_tape_seek (uptr, uptr->pos))                    /* set pos */
+if (sim_tape_seek_wr (uptr, uptr->pos))                 /* set pos */
     return MTSE_IOERR;
 switch (f) {                                            /* case on format */
 
@@ -2090,9 +2439,12 @@ switch (f) {                                            /* case on format */
             return sim_tape_ioerr (uptr);
             }
         uptr->pos = uptr->pos + sbc + (2 * sizeof (t_mtrlnt));  /* move tape */
+        sim_tape_wr_done (uptr);                        /* next write may follow on */
         break;
 
     case MTUF_F_P7B:                                    /* Pierce 7B */
+        ctx->wr_pending = FALSE;                        /* delimiter is overwritten next */
+        _sim_tape_p7b_index_free (uptr);                /* record layout changes */
         buf[0] = buf[0] | P7B_SOR;                      /* mark start of rec */
         (void)sim_fwrite (buf, sizeof (uint8), sbc, uptr->fileref);
         (void)sim_fwrite (buf, sizeof (uint8), 1, uptr->fileref); /* delimit rec */
@@ -2180,7 +2532,7 @@ if (ctx == NULL)                                        /* if not properly attac
     return sim_messagef (SCPE_IERR, "Bad Attach\n");    /*   that's a problem */
 if (sim_tape_wrp (uptr))                                /* write prot? */
     return MTSE_WRP;
-(void)sim_tape_seek (uptr, uptr->pos);                  /* set pos */
+(void)sim_tape_seek_wr (uptr, uptr->pos);               /* set pos */
 (void)sim_fwrite (&dat, sizeof (uint32), 1, uptr->fileref);
 if (ferror (uptr->fileref)) {                           /* error? */
     MT_SET_PNU (uptr);
@@ -2188,6 +2540,7 @@ if (ferror (uptr->fileref)) {                           /* error? */
     }
 sim_debug_unit (MTSE_DBG_STR, uptr, "wr_lnt: lnt: %d, pos: %" T_ADDR_FMT "u\n", dat, uptr->pos);
 uptr->pos = uptr->pos + sizeof (uint32);                /* move tape */
+sim_tape_wr_done (uptr);                                /* next write may follow on */
 if (uptr->pos > uptr->tape_eom)
     uptr->tape_eom = uptr->pos;                         /* update EOM */
 return MTSE_OK;
@@ -2198,6 +2551,7 @@ return MTSE_OK;
 t_stat sim_tape_wrtmk (UNIT *uptr)
 {
 struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+t_stat r;
 
 if (ctx == NULL)                                        /* if not properly attached? */
     return sim_messagef (SCPE_IERR, "Bad Attach\n");    /*   that's a problem */
@@ -2207,8 +2561,12 @@ if (MT_GET_FMT (uptr) == MTUF_F_P7B) {                  /* P7B? */
     return sim_tape_wrrecf (uptr, &buf, 1);             /* write char */
     }
 if (MT_GET_FMT (uptr) == MTUF_F_AWS)                    /* AWS? */
-    return sim_tape_aws_wrdata (uptr, NULL, 0);
-return sim_tape_wrdata (uptr, MTR_TMK);
+    r = sim_tape_aws_wrdata (uptr, NULL, 0);
+else
+    r = sim_tape_wrdata (uptr, MTR_TMK);
+if (r == MTSE_OK)
+    fflush (uptr->fileref);                             /* file boundary: write buffered data */
+return r;
 }
 
 t_stat sim_tape_wrtmk_a (UNIT *uptr, TAPE_PCALLBACK callback)
@@ -790,25 +790,6 @@ return written;
 }
 
 
-/* Remove a character from the read buffer.
-
-   The character at position "p" in the read buffer associated with line "lp" is
-   removed by moving all of the following received characters down one position.
-   The receive break status array is adjusted accordingly.
-*/
-
-static void tmxr_rmvrc (TMLN *lp, int32 p)
-{
-for ( ; p < lp->rxbpi; p++) {                           /* work from "p" through end of buffer */
-    lp->rxb[p] = lp->rxb[p + 1];                        /* slide following character down */
-    lp->rbr[p] = lp->rbr[p + 1];                        /* adjust break status too */
-    }
-
-lp->rbr[p] = 0;                                         /* clear potential break from vacated slot */
-lp->rxbpi = lp->rxbpi - 1;                              /* drop buffer insert index */
-}
-
-
 /* Find a line descriptor indicated by unit or number.
 
    If "uptr" is NULL, then the line descriptor is determined by the line number
@@ -1453,6 +1434,12 @@ if (lp->serport) {
     }
 else                                                    /* Telnet connection */
     if (lp->sock) {
+        if (lp->poll_sock == lp->sock) {                /* registered for readiness? */
+            if (lp->mp && lp->mp->poll_set)
+                sim_sock_poll_del (lp->mp->poll_set, lp->sock);
+            lp->poll_sock = 0;
+            lp->rx_ready = FALSE;
+            }
         sim_close_sock (lp->sock);                      /* close socket */
         free (lp->telnet_sent_opts);
         lp->telnet_sent_opts = NULL;
@@ -2099,6 +2086,74 @@ tmxr_debug_return(lp, val);
 return val;
 }
 
+/* Get characters from specific line
+
+   Inputs:
+        *lp     =       pointer to terminal line descriptor
+        *buf    =       buffer to receive characters
+        size    =       size of buffer
+        *got    =       pointer to count of characters returned
+   Output:
+        SCPE_OK         characters returned (possibly none)
+        SCPE_BREAK      a single character was returned which arrived
+                        coincident with a line break
+
+   Implementation notes:
+
+    1. This is equivalent to calling tmxr_getc_ln until it returns no data,
+       but moves all available characters with a single copy.  Data which
+       follows a line break is left for the next call so the break can be
+       reported against the character it arrived with.
+    2. Injected SEND data and receive rate limiting are honored by falling
+       back to tmxr_getc_ln.
+*/
+
+t_stat tmxr_get_buf_ln (TMLN *lp, uint8 *buf, size_t size, size_t *got)
+{
+size_t avail;
+int32 val;
+const char *brk;
+t_stat r = SCPE_OK;
+
+tmxr_debug_trace_line (lp, "tmxr_get_buf_ln()");
+*got = 0;
+if (size == 0)
+    return SCPE_OK;
+if (lp->rxbps ||                                        /* rate limited or SEND data? */
+    (lp->send.extoff < lp->send.insoff)) {
+    val = tmxr_getc_ln (lp);                            /* one character at a time */
+    if (val == 0)
+        return SCPE_OK;
+    buf[0] = (uint8)(val & 0377);
+    *got = 1;
+    return (val & SCPE_BREAK) ? SCPE_BREAK : SCPE_OK;
+    }
+if (!((lp->conn || lp->txbfd) && lp->rcve))             /* (conn or buffered) & enb? */
+    return SCPE_OK;
+avail = (size_t)(lp->rxbpi - lp->rxbpr);                /* # input chrs */
+if (avail > 0) {
+    if (lp->rbr[lp->rxbpr]) {                           /* break on first char? */
+        lp->rbr[lp->rxbpr] = 0;                         /* clear status */
+        avail = 1;
+        r = SCPE_BREAK;                                 /* indicate to caller */
+        }
+    else {
+        if (avail > size)
+            avail = size;
+        brk = (const char *)memchr (&lp->rbr[lp->rxbpr], 1, avail);
+        if (brk)                                        /* stop short of a break */
+            avail = (size_t)(brk - &lp->rbr[lp->rxbpr]);
+        }
+    memcpy (buf, &lp->rxb[lp->rxbpr], avail);
+    lp->rxbpr = lp->rxbpr + (int32)avail;               /* adv pointer */
+    *got = avail;
+    lp->rxnexttime = floor (sim_gtime () + ((lp->mp->uptr->wait * sim_timer_inst_per_sec ()) / USECS_PER_SECOND));
+    }
+if (lp->rxbpi == lp->rxbpr)                             /* empty? zero ptrs */
+    lp->rxbpi = lp->rxbpr = 0;
+return r;
+}
+
 /* Get packet from specific line
 
    Inputs:
@@ -2166,6 +2221,85 @@ if (lp->conn)
 return SCPE_LOST;
 }
 
+/* Collect socket readiness for a multiplexer
+
+   TCP line sockets are registered (edge triggered) in a per multiplexer
+   readiness set the first time they are polled, with the line number as the
+   token.  Each receive poll drains the set once and marks the lines which
+   have become readable, so that only those lines are read.  A line stays
+   marked until a read returns less than was asked for, which means the
+   socket has been drained and a new edge will be reported for further data.
+
+   If the host has no readiness facility, or the set fails, every line is
+   read on every poll as before.
+*/
+
+#define TMXR_POLL_EVENTS        64                      /* events per wait */
+
+static t_bool _tmxr_line_in_poll_set (const TMLN *lp)
+{
+return (lp->sock && !lp->serport && !lp->loopback && !lp->framer &&
+        !lp->datagram && (lp->mp != NULL) && !lp->mp->poll_failed);
+}
+
+static t_bool _tmxr_poll_add (TMXR *mp, TMLN *lp)
+{
+if (mp->poll_set == NULL) {
+    mp->poll_set = sim_sock_poll_open ();
+    if (mp->poll_set == NULL) {
+        mp->poll_failed = TRUE;
+        return FALSE;
+        }
+    }
+if (sim_sock_poll_add (mp->poll_set, lp->sock, (int)(lp - mp->ldsc)) != 0)
+    return FALSE;
+lp->poll_sock = lp->sock;
+lp->rx_ready = TRUE;                                    /* may already hold data */
+return TRUE;
+}
+
+static void _tmxr_poll_ready (TMXR *mp)
+{
+int tokens[TMXR_POLL_EVENTS];
+int32 i;
+int n;
+
+if (mp->poll_set == NULL)                               /* no sockets registered yet */
+    return;
+do {
+    n = sim_sock_poll_wait (mp->poll_set, tokens, TMXR_POLL_EVENTS, 0);
+    for (i = 0; i < n; i++) {
+        if ((tokens[i] >= 0) && (tokens[i] < mp->lines))
+            mp->ldsc[tokens[i]].rx_ready = TRUE;
+        }
+    } while (n == TMXR_POLL_EVENTS);
+if (n < 0) {                                            /* set broken? */
+    sim_sock_poll_close (mp->poll_set);                 /* revert to reading every line */
+    mp->poll_set = NULL;
+    mp->poll_failed = TRUE;
+    for (i = 0; i < mp->lines; i++) {
+        mp->ldsc[i].poll_sock = 0;
+        mp->ldsc[i].rx_ready = FALSE;
+        }
+    }
+}
+
+/* Release the readiness set of a multiplexer */
+
+static void _tmxr_poll_close (TMXR *mp)
+{
+int32 i;
+
+if (mp->poll_set)
+    sim_sock_poll_close (mp->poll_set);
+mp->poll_set = NULL;
+mp->poll_failed = FALSE;
+for (i = 0; i < mp->lines; i++) {
+    mp->ldsc[i].poll_sock = 0;
+    mp->ldsc[i].rx_ready = FALSE;
+    }
+}
+
 /* Poll for input
 
    Inputs:
@@ -2175,25 +2309,41 @@ return SCPE_LOST;
 
 void tmxr_poll_rx (TMXR *mp)
 {
-int32 i, nbytes, j;
+int32 i, nbytes, j, want;
 TMLN *lp;
+t_bool polled;
 
 tmxr_debug_trace (mp, "tmxr_poll_rx()");
+_tmxr_poll_ready (mp);                                  /* note lines with data */
 for (i = 0; i < mp->lines; i++) {                       /* loop thru lines */
     lp = mp->ldsc + i;                                  /* get line desc */
     if (!(lp->sock || lp->serport || lp->loopback || lp->framer) ||
         !(lp->rcve))                                    /* skip if not connected */
         continue;
 
+    polled = _tmxr_line_in_poll_set (lp);
+    if (polled) {
+        if (lp->poll_sock != lp->sock) {                /* new socket? */
+            lp->poll_sock = 0;
+            polled = _tmxr_poll_add (mp, lp);           /* register it */
+            }
+        else
+            if (!lp->rx_ready)                          /* nothing arrived? */
+                continue;
+        }
+
     nbytes = 0;
+    want = 0;
     if (lp->rxbpi == 0)                                 /* need input? */
         nbytes = tmxr_read (lp,                         /* yes, read */
-            lp->rxbsz - TMXR_GUARD);                    /* leave spc for Telnet cruft */
+            want = lp->rxbsz - TMXR_GUARD);             /* leave spc for Telnet cruft */
     else {
         if (lp->tsta)                                   /* in Telnet seq? */
             nbytes = tmxr_read (lp,                     /* yes, read to end */
-                                    lp->rxbsz - lp->rxbpi);
+                                    want = lp->rxbsz - lp->rxbpi);
         }
+    if (polled && want && (nbytes >= 0) && (nbytes < want))
+        lp->rx_ready = FALSE;                           /* drained, wait for next edge */
 
     if (nbytes < 0) {                                   /* line error? */
         if (!lp->datagram) {                            /* ignore errors reading UDP sockets */
@@ -2214,32 +2364,35 @@ for (i = 0; i < mp->lines; i++) {                       /* loop thru lines */
 /* Examine new data, remove TELNET cruft before making input available */
 
         if (!lp->notelnet) {                            /* Are we looking for telnet interpretation? */
-            for (; j < lp->rxbpi; ) {                   /* loop thru char */
+            int32 k = j;                                /* filtered insert index */
+            int32 end = lp->rxbpi;                      /* end of new data */
+
+            for (; j < end; ) {                         /* loop thru char */
                 u_char tmp = (u_char)lp->rxb[j];        /* get char */
+                t_bool keep = FALSE;                    /* dropped unless kept */
                 switch (lp->tsta) {                     /* case tlnt state */
 
                 case TNS_NORM:                          /* normal */
                     if (tmp == TN_IAC) {                /* IAC? */
                         lp->tsta = TNS_IAC;             /* change state */
-                        tmxr_rmvrc (lp, j);             /* remove char */
                         break;
                         }
                     if ((tmp == TN_CR) && lp->dstb)     /* CR, no bin */
                         lp->tsta = TNS_CRPAD;           /* skip pad char */
-                    j = j + 1;                          /* advance j */
+                    keep = TRUE;                        /* keep char */
                     break;
 
                 case TNS_IAC:                           /* IAC prev */
                     if (tmp == TN_IAC) {                /* IAC + IAC */
                         lp->tsta = TNS_NORM;            /* treat as normal */
-                        j = j + 1;                      /* advance j */
+                        keep = TRUE;                    /* keep char */
                         break;                          /* keep IAC */
                         }
                     if (tmp == TN_BRK) {                /* IAC + BRK? */
                         lp->tsta = TNS_NORM;            /* treat as normal */
                         lp->rxb[j] = 0;                 /* char is null */
                         lp->rbr[j] = 1;                 /* flag break */
-                        j = j + 1;                      /* advance j */
+                        keep = TRUE;                    /* keep char */
                         break;
                         }
                     switch (tmp) {
@@ -2267,7 +2420,6 @@ for (i = 0; i < mp->lines; i++) {                       /* loop thru lines */
                         lp->tsta = TNS_NORM;            /* ignore */
                         break;
                         }
-                    tmxr_rmvrc (lp, j);                 /* remove char */
                     break;
 
                 case TNS_WILL:                          /* IAC+WILL prev */
@@ -2324,7 +2476,6 @@ for (i = 0; i < mp->lines; i++) {                       /* loop thru lines */
                             lp->dstb = 1;
                             }
                         }
-                    tmxr_rmvrc (lp, j);                 /* remove it */
                     lp->tsta = TNS_NORM;                /* next normal */
                     break;
 
@@ -2346,8 +2497,8 @@ for (i = 0; i < mp->lines; i++) {                       /* loop thru lines */
                     lp->tsta = TNS_NORM;                /* next normal */
                     if ((tmp == TN_LF) ||               /* CR + LF ? */
                         (tmp == TN_NUL))                /* CR + NUL? */
-                        tmxr_rmvrc (lp, j);             /* remove it */
-                    break;
+                        break;                          /* remove it */
+                    continue;                           /* else reexamine as normal */
 
                 case TNS_DO:                            /* pending DO request */
                     if ((tmp == TN_STATUS) ||
@@ -2396,11 +2547,19 @@ for (i = 0; i < mp->lines; i++) {                       /* loop thru lines */
                         }
                     /* fall through */
                 case TNS_SKIP: default:                 /* skip char */
-                    tmxr_rmvrc (lp, j);                 /* remove char */
                     lp->tsta = TNS_NORM;                /* next normal */
                     break;
                     }                                   /* end case state */
+                if (keep) {                             /* copy down over removed chars */
+                    lp->rxb[k] = lp->rxb[j];
+                    lp->rbr[k] = lp->rbr[j];
+                    k = k + 1;
+                    }
+                j = j + 1;                              /* advance j */
                 }                                       /* end for char */
+            if (k < end)                                /* clear vacated break status */
+                memset (&lp->rbr[k], 0, end - k);
+            lp->rxbpi = k;                              /* drop buffer insert index */
             if (nbytes != (lp->rxbpi-lp->rxbpr)) {
                 tmxr_debug (TMXR_DBG_RCV, lp, "Remaining", &(lp->rxb[lp->rxbpr]), lp->rxbpi-lp->rxbpr);
                 }
@@ -2509,6 +2668,87 @@ if ((lp->conn && (TXBUF_AVAIL(lp) > 1)) ||              /* connected and room fo
 return SCPE_STALL;                                      /* char not sent */
 }
 
+/* Store characters in line buffer
+
+   Inputs:
+        *lp     =       pointer to line descriptor
+        *buf    =       pointer to data
+        size    =       count of characters
+        *sent   =       pointer to count of characters stored
+   Outputs:
+        status  =       ok, connection lost, or stall
+
+   Implementation notes:
+
+    1. The result is the same as calling tmxr_putc_ln for each character
+       until one fails.  When the line is connected, not rate limited and
+       has no expect rules, runs of characters are copied into the transmit
+       ring directly instead of one at a time.
+    2. If fewer than size characters could be stored, SCPE_STALL is returned
+       with *sent holding the number stored.  The caller should retry the
+       remainder later.
+*/
+
+t_stat tmxr_put_buf_ln (TMLN *lp, const uint8 *buf, size_t size, size_t *sent)
+{
+size_t n = 0, run;
+int32 avail;
+const uint8 *iac;
+t_stat r = SCPE_OK;
+
+tmxr_debug_trace_line (lp, "tmxr_put_buf_ln()");
+if ((!lp->conn) || lp->serport || lp->txbps ||          /* not the simple case? */
+    (lp->expect.rules != NULL) || !sim_is_running) {
+    while ((n < size) && (SCPE_OK == (r = tmxr_putc_ln (lp, buf[n]))))
+        ++n;
+    *sent = n;
+    return r;
+    }
+if ((lp->xmte == 0) && (TXBUF_AVAIL(lp) > 1))
+    lp->xmte = 1;                                       /* enable line transmit */
+while (n < size) {
+    avail = TXBUF_AVAIL(lp);
+    if (avail <= 1)                                     /* room for char (+ IAC)? */
+        break;
+    if ((!lp->notelnet) && (buf[n] == TN_IAC)) {        /* IAC in telnet session? */
+        TXBUF_CHAR (lp, TN_IAC);                        /* stuff extra IAC char */
+        TXBUF_CHAR (lp, TN_IAC);
+        ++n;
+        continue;
+        }
+    run = size - n;                                     /* longest run that fits */
+    if (run > (size_t)(avail - 1))
+        run = (size_t)(avail - 1);
+    if (run > (size_t)(lp->txbsz - lp->txbpi))          /* and does not wrap */
+        run = (size_t)(lp->txbsz - lp->txbpi);
+    if ((!lp->notelnet) &&                              /* stop short of any IAC */
+        (NULL != (iac = (const uint8 *)memchr (&buf[n], TN_IAC, run))))
+        run = (size_t)(iac - &buf[n]);
+    memcpy (&lp->txb[lp->txbpi], &buf[n], run);
+    lp->txbpi = (lp->txbpi + (int32)run) % lp->txbsz;
+    n += run;
+    }
+if (n > 0) {
+    if ((!lp->txbfd) &&
+        (TXBUF_AVAIL (lp) <= TMXR_GUARD))               /* near full? */
+        lp->xmte = 0;                                   /* disable line transmit until space available */
+    if (lp->txlog) {                                    /* log if available */
+        extern TMLN *sim_oline;                         /* Make sure to avoid recursion */
+        TMLN *save_oline = sim_oline;                   /* when logging to a socket */
+
+        sim_oline = NULL;                               /* save output socket */
+        fwrite (buf, 1, n, lp->txlog);                  /* log to actual file */
+        sim_oline = save_oline;                         /* restore output socket */
+        }
+    }
+*sent = n;
+if (n < size) {
+    ++lp->txstall; lp->xmte = 0;                        /* no room, dsbl line */
+    return SCPE_STALL;                                  /* chars not sent */
+    }
+return SCPE_OK;
+}
+
 /* Store packet in line buffer
 
    Inputs:
@@ -4722,6 +4962,7 @@ if (mp->ring_sock != INVALID_SOCKET) {
     mp->ring_ipad = NULL;
     mp->ring_start_time = 0;
     }
+_tmxr_poll_close (mp);
 _tmxr_remove_from_open_list (mp);
 return SCPE_OK;
 }
@@ -6143,6 +6384,92 @@ return SCPE_OK;
 
 #include <setjmp.h>
 
+/* tmxr_put_buf_ln and tmxr_get_buf_ln must leave a line in the same
+   state as the equivalent tmxr_putc_ln and tmxr_getc_ln calls.  The lines
+   are never really connected, sim_is_running keeps the data in the
+   buffers. */
+
+#define BUFIO_BSZ       64
+
+static t_stat sim_tmxr_test_bufio (void)
+{
+TMXR mux;
+TMLN ln[2];
+UNIT unit;
+uint8 data[3 * BUFIO_BSZ], got[BUFIO_BSZ];
+char txb[2][BUFIO_BSZ], rxb[BUFIO_BSZ], rbr[BUFIO_BSZ];
+t_bool saved_running = sim_is_running;
+size_t i, n, sent, cnt;
+int32 l, start;
+t_stat r, r1, result = SCPE_OK;
+
+memset (&mux, 0, sizeof (mux));
+memset (ln, 0, sizeof (ln));
+memset (&unit, 0, sizeof (unit));
+mux.ldsc = ln;
+mux.lines = 2;
+mux.uptr = &unit;
+for (i = 0; i < sizeof (data); i++)
+    data[i] = (uint8)(i * 7);                       /* TN_IAC at 73 */
+data[5] = data[6] = TN_IAC;
+sim_is_running = TRUE;
+for (start = 0; start < BUFIO_BSZ; start += 13) {   /* wrap at many places */
+    for (n = 0; n <= sizeof (data); n += 11) {      /* up to stalling */
+        for (l = 0; l < 2; l++) {
+            ln[l].mp = &mux;
+            ln[l].conn = 1;
+            ln[l].xmte = 1;
+            ln[l].txb = txb[l];
+            ln[l].txbsz = BUFIO_BSZ;
+            ln[l].txbpi = ln[l].txbpr = start;
+            ln[l].txstall = ln[l].txdrp = 0;
+            memset (txb[l], 0, BUFIO_BSZ);
+            }
+        r = tmxr_put_buf_ln (&ln[0], data, n, &sent);
+        for (i = 0, r1 = SCPE_OK; (i < n) && (SCPE_OK == (r1 = tmxr_putc_ln (&ln[1], data[i]))); i++)
+            ;
+        if ((r != r1) || (sent != i) ||
+            (ln[0].txbpi != ln[1].txbpi) || (ln[0].txbpr != ln[1].txbpr) ||
+            (ln[0].xmte != ln[1].xmte) || (ln[0].txstall != ln[1].txstall) ||
+            (ln[0].txdrp != ln[1].txdrp) ||
+            (memcmp (txb[0], txb[1], BUFIO_BSZ) != 0)) {
+            result = sim_messagef (SCPE_IERR, "tmxr_put_buf_ln() of %d characters at %d differs from tmxr_putc_ln()\n", (int)n, (int)start);
+            goto Done;
+            }
+        }
+    }
+ln[0].rcve = 1;                                     /* input: a break after 8 */
+ln[0].rxb = rxb;
+ln[0].rbr = rbr;
+ln[0].rxbsz = BUFIO_BSZ;
+for (i = 0; i < 20; i++)
+    rxb[i] = (char)('a' + i);
+memset (rbr, 0, sizeof (rbr));
+rbr[8] = 1;
+ln[0].rxbpr = 0;
+ln[0].rxbpi = 20;
+cnt = 0;
+if ((tmxr_get_buf_ln (&ln[0], got, 3, &n) != SCPE_OK) || (n != 3) ||
+    (memcmp (got, rxb, 3) != 0))
+    cnt = 1;
+else if ((tmxr_get_buf_ln (&ln[0], got, sizeof (got), &n) != SCPE_OK) || (n != 5) ||
+    (memcmp (got, rxb + 3, 5) != 0))
+    cnt = 2;
+else if ((tmxr_get_buf_ln (&ln[0], got, sizeof (got), &n) != SCPE_BREAK) || (n != 1) ||
+    (got[0] != (uint8)rxb[8]) || (rbr[8] != 0))
+    cnt = 3;
+else if ((tmxr_get_buf_ln (&ln[0], got, sizeof (got), &n) != SCPE_OK) || (n != 11) ||
+    (memcmp (got, rxb + 9, 11) != 0) || (ln[0].rxbpi != 0) || (ln[0].rxbpr != 0))
+    cnt = 4;
+else if ((tmxr_get_buf_ln (&ln[0], got, sizeof (got), &n) != SCPE_OK) || (n != 0))
+    cnt = 5;
+if (cnt != 0)
+    result = sim_messagef (SCPE_IERR, "tmxr_get_buf_ln() step %d returned the wrong data\n", (int)cnt);
+Done:
+sim_is_running = saved_running;
+return result;
+}
+
 t_stat tmxr_sock_test (DEVICE *dptr, const char *cptr)
 {
 char cmd[CBUFSIZE], host[CBUFSIZE], port[CBUFSIZE];
@@ -6171,6 +6498,7 @@ SIM_TEST((sim_parse_addr ("localhost:6666", host, sizeof(host), "localhost", por
 SIM_TEST(sim_parse_addr ("localhost:66666", host, sizeof(host), "localhost", port, sizeof(port), "1234", NULL) != -1);
 SIM_TEST((sim_parse_addr ("localhost:telnet", host, sizeof(host), "localhost", port, sizeof(port), "1234", NULL) == -1) || (strcmp(host, "localhost")) || (strcmp(port,"telnet")));
 SIM_TEST((sim_parse_addr ("telnet", host, sizeof(host), "localhost", port, sizeof(port), "1234", NULL) == -1) || (strcmp(host, "localhost")) || (strcmp(port,"telnet")));
+SIM_TEST(sim_tmxr_test_bufio ());
 dptr->dctrl = 0xFFFFFFFF;
 dptr->dctrl &= ~TMXR_DBG_TRC;
 sprintf (cmd, "%s -u localhost:65500;telnet;nomessage", dptr->name);
@@ -212,6 +212,8 @@ struct tmln {
     EXPECT              expect;                         /* Expect rules */
     SEND                send;                           /* Send input state */
     struct framer_data  *framer;                        /* ddcmp framer data */
+    SOCKET              poll_sock;                      /* socket registered in mux poll set */
+    t_bool              rx_ready;                       /* poll set reported data pending */
     };
 
 struct tmxr {
@@ -240,6 +242,8 @@ struct tmxr {
     t_bool              port_speed_control;             /* multiplexer programmatically sets port speed */
     t_bool              packet;                         /* Lines are packet oriented */
     t_bool              datagram;                       /* Lines use datagram packet transport */
+    SIM_SOCK_POLLSET    *poll_set;                      /* socket readiness set (NULL if none) */
+    t_bool              poll_failed;                    /* readiness set unavailable on this host */
     };
 
 int32 tmxr_poll_conn (TMXR *mp);
@@ -247,10 +251,12 @@ t_stat tmxr_reset_ln (TMLN *lp);
 t_stat tmxr_detach_ln (TMLN *lp);
 int32 tmxr_input_pending_ln (TMLN *lp);
 int32 tmxr_getc_ln (TMLN *lp);
+t_stat tmxr_get_buf_ln (TMLN *lp, uint8 *buf, size_t size, size_t *got);
 t_stat tmxr_get_packet_ln (TMLN *lp, const uint8 **pbuf, size_t *psize);
 t_stat tmxr_get_packet_ln_ex (TMLN *lp, const uint8 **pbuf, size_t *psize, uint8 frame_byte);
 void tmxr_poll_rx (TMXR *mp);
 t_stat tmxr_putc_ln (TMLN *lp, int32 chr);
+t_stat tmxr_put_buf_ln (TMLN *lp, const uint8 *buf, size_t size, size_t *sent);
 t_stat tmxr_put_packet_ln (TMLN *lp, const uint8 *buf, size_t size);
 t_stat tmxr_put_packet_ln_ex (TMLN *lp, const uint8 *buf, size_t size, uint8 frame_byte);
 void tmxr_poll_tx (TMXR *mp);
@@ -379,6 +379,11 @@ t_bool vid_blending;
 SDL_Rect *vid_dst_last;
 SDL_Rect vid_rect;
 uint32 *vid_data_last;
+uint32 *vid_fb;                                         /* persistent frame buffer */
+SDL_Rect vid_dirty;                                     /* damaged region of vid_fb */
+t_bool vid_draw_pending;                                /* frame buffer EVENT_DRAW queued */
+uint32 vid_fb_draws;                                    /* draws into vid_fb */
+uint32 vid_fb_updates;                                  /* texture uploads from vid_fb */
 };
 
 SDL_Thread *vid_thread_handle = NULL;                   /* event thread handle */
@@ -726,6 +731,12 @@ vptr->vid_mouse_captured = FALSE;
 vptr->vid_cursor_visible = (vptr->vid_flags & SIM_VID_INPUTCAPTURED);
 vptr->vid_blending = FALSE;
 vptr->vid_ready = FALSE;
+vptr->vid_dirty.w = vptr->vid_dirty.h = 0;
+vptr->vid_draw_pending = FALSE;
+vptr->vid_fb_draws = vptr->vid_fb_updates = 0;
+vptr->vid_fb = (uint32 *)calloc ((size_t)width * height, sizeof (*vptr->vid_fb));
+if (vptr->vid_fb == NULL)
+    return SCPE_MEM;
 
 if (!vid_active) {
     vid_key_events.head = 0;
@@ -744,8 +755,11 @@ memset (motion_callback, 0, sizeof motion_callback);
 memset (button_callback, 0, sizeof button_callback);
 
 stat = vid_create_window (vptr);
-if (stat != SCPE_OK)
+if (stat != SCPE_OK) {
+    free (vptr->vid_fb);
+    vptr->vid_fb = NULL;
     return stat;
+    }
 
 sim_debug (SIM_VID_DBG_VIDEO|SIM_VID_DBG_KEY|SIM_VID_DBG_MOUSE, vptr->vid_dev, "vid_open() - Success\n");
 
@@ -802,6 +816,8 @@ while (vptr->vid_ready)
     sim_os_ms_sleep (10);
 
 vptr->vid_active_window = FALSE;
+free (vptr->vid_fb);
+vptr->vid_fb = NULL;
 if (!vid_active && vid_mouse_events.sem) {
     SDL_DestroySemaphore(vid_mouse_events.sem);
     vid_mouse_events.sem = NULL;
@@ -900,6 +916,76 @@ uint32 *vid_data;
 
 sim_debug (SIM_VID_DBG_VIDEO, vptr->vid_dev, "vid_draw(%d, %d, %d, %d)\n", x, y, w, h);
 
+/* Opaque windows draw straight into the persistent frame buffer and
+   only record the damaged area.  A single EVENT_DRAW is kept queued
+   and uploads the union of everything drawn since the last one.
+   Blended windows must composite each draw separately, so they
+   still queue a copy of every region. */
+if (!vptr->vid_blending && vptr->vid_fb) {
+    int32 pitch = w;
+    int32 row;
+    t_bool pending;
+
+    if (x < 0) {                                        /* clip to the frame buffer */
+        buf -= x;
+        w += x;
+        x = 0;
+        }
+    if (y < 0) {
+        buf -= y * pitch;
+        h += y;
+        y = 0;
+        }
+    if (x + w > vptr->vid_width)
+        w = vptr->vid_width - x;
+    if (y + h > vptr->vid_height)
+        h = vptr->vid_height - y;
+    if ((w <= 0) || (h <= 0))
+        return;
+    SDL_LockMutex (vptr->vid_draw_mutex);
+    for (row = 0; row < h; row++)
+        memcpy (vptr->vid_fb + (y + row) * vptr->vid_width + x, buf + row * pitch, w * sizeof (*buf));
+    ++vptr->vid_fb_draws;
+    if ((vptr->vid_dirty.w == 0) || (vptr->vid_dirty.h == 0)) {
+        vptr->vid_dirty.x = x;
+        vptr->vid_dirty.y = y;
+        vptr->vid_dirty.w = w;
+        vptr->vid_dirty.h = h;
+        }
+    else {                                              /* merge with pending damage */
+        int32 x2 = vptr->vid_dirty.x + vptr->vid_dirty.w;
+        int32 y2 = vptr->vid_dirty.y + vptr->vid_dirty.h;
+
+        if (x + w > x2)
+            x2 = x + w;
+        if (y + h > y2)
+            y2 = y + h;
+        if (x < vptr->vid_dirty.x)
+            vptr->vid_dirty.x = x;
+        if (y < vptr->vid_dirty.y)
+            vptr->vid_dirty.y = y;
+        vptr->vid_dirty.w = x2 - vptr->vid_dirty.x;
+        vptr->vid_dirty.h = y2 - vptr->vid_dirty.y;
+        }
+    pending = vptr->vid_draw_pending;
+    vptr->vid_draw_pending = TRUE;
+    SDL_UnlockMutex (vptr->vid_draw_mutex);
+    if (pending)                                        /* already queued? */
+        return;
+    user_event.type = SDL_USEREVENT;
+    user_event.user.windowID = vptr->vid_windowID;
+    user_event.user.code = EVENT_DRAW;
+    user_event.user.data1 = NULL;                       /* NULL region means frame buffer */
+    user_event.user.data2 = NULL;
+    if (SDL_PushEvent (&user_event) < 0) {
+        sim_printf ("%s: vid_draw() SDL_PushEvent error: %s\n", vid_dname(vptr->vid_dev), SDL_GetError());
+        SDL_LockMutex (vptr->vid_draw_mutex);           /* let the next draw retry */
+        vptr->vid_draw_pending = FALSE;
+        SDL_UnlockMutex (vptr->vid_draw_mutex);
+        }
+    return;
+    }
+
 SDL_LockMutex (vptr->vid_draw_mutex);                         /* Synchronize to check region dimensions */
 last = vptr->vid_dst_last;
 if (last                               &&               /* As yet unprocessed draw rectangle? */
@@ -1783,6 +1869,23 @@ void vid_draw_region (VID_DISPLAY *vptr, SDL_UserEvent *event)
 SDL_Rect *vid_dst = (SDL_Rect *)event->data1;
 uint32 *buf = (uint32 *)event->data2;
 
+if (vid_dst == NULL) {                                  /* frame buffer update */
+    SDL_Rect dirty;
+
+    SDL_LockMutex (vptr->vid_draw_mutex);
+    dirty = vptr->vid_dirty;
+    vptr->vid_dirty.w = vptr->vid_dirty.h = 0;
+    vptr->vid_draw_pending = FALSE;
+    sim_debug (SIM_VID_DBG_VIDEO, vptr->vid_dev, "Draw Frame Buffer Event: (%d,%d,%d,%d)\n", dirty.x, dirty.y, dirty.w, dirty.h);
+    if ((dirty.w > 0) && (dirty.h > 0) && vptr->vid_fb) {
+        ++vptr->vid_fb_updates;
+        if (SDL_UpdateTexture(vptr->vid_texture, &dirty, vptr->vid_fb + dirty.y * vptr->vid_width + dirty.x, vptr->vid_width*sizeof(*vptr->vid_fb)))
+            sim_printf ("%s: vid_draw_region() - SDL_UpdateTexture error: %s\n", vid_dname(vptr->vid_dev), SDL_GetError());
+        }
+    SDL_UnlockMutex (vptr->vid_draw_mutex);
+    return;
+    }
+
 sim_debug (SIM_VID_DBG_VIDEO, vptr->vid_dev, "Draw Region Event: (%d,%d,%d,%d)\n", vid_dst->x, vid_dst->x, vid_dst->w, vid_dst->h);
 
 SDL_LockMutex (vptr->vid_draw_mutex);
@@ -1869,6 +1972,8 @@ else
 memset (&vptr->vid_key_state, 0, sizeof(vptr->vid_key_state));
 vptr->vid_dst_last = NULL;
 vptr->vid_data_last = NULL;
+vptr->vid_dirty.w = vptr->vid_dirty.h = 0;
+vptr->vid_draw_pending = FALSE;
 
 vid_active++;
 return 1;
@@ -2352,6 +2457,8 @@ else {
         if (!vptr->vid_active_window)
             continue;
         fprintf (st, "  Currently Active Video Window: (%d by %d pixels)\n", vptr->vid_width, vptr->vid_height);
+        if (!vptr->vid_blending && vptr->vid_fb)
+            fprintf (st, "  Frame buffer: %u draws sent in %u texture updates\n", vptr->vid_fb_draws, vptr->vid_fb_updates);
         fprintf (st, "  ");
         vid_show_release_key (st, uptr, val, desc);
         }